@@ -0,0 +1,814 @@
+//--------------------------------------------------------
+// musket/bench/bench.cpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#include <new>
+#include <cmath>
+#include <atomic>
+#include <thread>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+#include <musket.hpp>
+#include <psapi.h>
+#include "bench.hpp"
+#include "verify.hpp"
+
+void* operator new(std::size_t n)
+{
+	bench::allocation_count.fetch_add( 1, std::memory_order_relaxed );
+	if( auto const p = std::malloc( n ? n : 1 ) ) {
+		return p;
+	}
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free( p );
+}
+
+class cell :
+	public musket::widget_facade
+{
+	std::uint64_t hits_ = 0;
+
+public:
+	using widget_facade::widget_facade;
+
+	void on_event(musket::event::mouse_button_pressed, musket::window&, musket::mouse_button, musket::mouse_button, musket::cursor_position const&)
+	{
+		++hits_;
+	}
+
+	void on_event(musket::event::mouse_moved, musket::window&, musket::mouse_button, musket::cursor_position const&)
+	{
+		++hits_;
+	}
+
+	void on_event(musket::event::mouse_entered, musket::window&, musket::mouse_button)
+	{
+		++hits_;
+	}
+
+	void on_event(musket::event::mouse_leaved, musket::window&, musket::mouse_button)
+	{
+		++hits_;
+	}
+};
+
+constexpr float cell_size = 4.0f;
+constexpr std::size_t cell_cols = 250;
+
+spirea::rect_t< float > cell_rect(std::size_t i) noexcept
+{
+	return { { cell_size * ( i % cell_cols ), cell_size * ( i / cell_cols ) }, { cell_size, cell_size } };
+}
+
+musket::input_record mouse_input(musket::input_kind kind, std::int32_t x, std::int32_t y) noexcept
+{
+	musket::input_record r;
+	r.kind = kind;
+	r.button = kind == musket::input_kind::mouse_moved ? musket::mouse_button::none : musket::mouse_button::left;
+	r.position = { x, y };
+	return r;
+}
+
+std::size_t private_bytes() noexcept
+{
+	PROCESS_MEMORY_COUNTERS_EX pmc = {};
+	K32GetProcessMemoryInfo( GetCurrentProcess(), reinterpret_cast< PROCESS_MEMORY_COUNTERS* >( &pmc ), sizeof( pmc ) );
+	return pmc.PrivateUsage;
+}
+
+std::chrono::microseconds process_cpu_time() noexcept
+{
+	FILETIME creation, exit, kernel, user;
+	GetProcessTimes( GetCurrentProcess(), &creation, &exit, &kernel, &user );
+	auto const to_100ns = [](FILETIME const& ft) {
+		return ( static_cast< std::uint64_t >( ft.dwHighDateTime ) << 32 ) | ft.dwLowDateTime;
+	};
+	return std::chrono::microseconds{ ( to_100ns( kernel ) + to_100ns( user ) ) / 10 };
+}
+
+void pump_messages() noexcept
+{
+	MSG msg;
+	while( PeekMessageW( &msg, nullptr, 0, 0, PM_REMOVE ) ) {
+		TranslateMessage( &msg );
+		DispatchMessageW( &msg );
+	}
+}
+
+class background_thread
+{
+	std::atomic< bool > stop_{ false };
+	std::thread th_;
+
+public:
+	template <typename F>
+	explicit background_thread(F&& f) :
+		th_{ [this, f = std::forward< F >( f )]() mutable { f( stop_ ); } }
+	{ }
+
+	~background_thread() noexcept
+	{
+		stop_.store( true, std::memory_order_relaxed );
+		th_.join();
+	}
+
+	background_thread(background_thread const&) = delete;
+	background_thread& operator=(background_thread const&) = delete;
+};
+
+template <typename T>
+void detach_all(std::vector< musket::widget< T > >& ws)
+{
+	for( auto& w : ws ) {
+		musket::detach( w );
+	}
+	ws.clear();
+}
+
+void bench_dispatch(bench::runner& r, musket::window& wnd)
+{
+	constexpr std::size_t batch = 1000;
+
+	for( std::size_t n : { 1, 100, 10000, 100000 } ) {
+		if( !r.enabled( "dispatch/" ) && !r.enabled( "hit_test/" ) ) {
+			return;
+		}
+
+		std::vector< musket::widget< cell > > cells;
+		cells.reserve( n );
+		for( std::size_t i = 0; i < n; ++i ) {
+			cells.emplace_back( cell_rect( i ) );
+			wnd.attach_widget( cells.back() );
+		}
+
+		auto const span = static_cast< std::int32_t >( std::min( n, cell_cols ) * cell_size );
+		auto const suffix = "/" + std::to_string( n );
+
+		r.run( "dispatch/mouse_moved" + suffix, batch, [&] {
+			for( std::size_t i = 0; i < batch; ++i ) {
+				wnd.dispatch_input( mouse_input( musket::input_kind::mouse_moved, static_cast< std::int32_t >( i ) % span, 1 ) );
+			}
+		} );
+
+		r.run( "dispatch/mouse_button" + suffix, batch, [&] {
+			for( std::size_t i = 0; i < batch; i += 2 ) {
+				auto const x = static_cast< std::int32_t >( i ) % span;
+				wnd.dispatch_input( mouse_input( musket::input_kind::mouse_button_pressed, x, 1 ) );
+				wnd.dispatch_input( mouse_input( musket::input_kind::mouse_button_released, x, 1 ) );
+			}
+		} );
+
+		r.run( "hit_test/miss" + suffix, batch, [&] {
+			for( std::size_t i = 0; i < batch; ++i ) {
+				wnd.dispatch_input( mouse_input( musket::input_kind::mouse_moved, -10, -10 ) );
+			}
+		} );
+
+		r.run( "hit_test/bottommost" + suffix, batch, [&] {
+			for( std::size_t i = 0; i < batch; ++i ) {
+				wnd.dispatch_input( mouse_input( musket::input_kind::mouse_moved, 1, 1 ) );
+			}
+		} );
+
+		detach_all( cells );
+	}
+}
+
+void bench_connect(bench::runner& r, musket::window& wnd)
+{
+	constexpr std::size_t batch = 100;
+
+	for( std::size_t n : { 0, 1000, 100000 } ) {
+		if( !r.enabled( "connect/" ) ) {
+			return;
+		}
+
+		std::vector< musket::widget< cell > > cells;
+		cells.reserve( n );
+		for( std::size_t i = 0; i < n; ++i ) {
+			cells.emplace_back( cell_rect( i ) );
+			wnd.attach_widget( cells.back() );
+		}
+
+		std::vector< musket::widget< cell > > extra;
+		for( std::size_t i = 0; i < batch; ++i ) {
+			extra.emplace_back( cell_rect( i ) );
+		}
+
+		r.run( "connect/attach_detach/" + std::to_string( n ), batch, [&] {
+			for( auto& w : extra ) {
+				wnd.attach_widget( w );
+			}
+			for( auto& w : extra ) {
+				musket::detach( w );
+			}
+		} );
+
+		detach_all( cells );
+	}
+}
+
+void bench_arena(bench::runner& r, musket::window& wnd)
+{
+	constexpr std::size_t n = 1000;
+
+	auto build = [&](std::pmr::memory_resource* mr) {
+		std::vector< musket::widget< cell > > cells;
+		cells.reserve( n );
+		for( std::size_t i = 0; i < n; ++i ) {
+			cells.emplace_back( std::allocator_arg, mr, cell_rect( i ) );
+			wnd.attach_widget( cells.back() );
+		}
+		detach_all( cells );
+	};
+
+	r.run( "arena/build_screen/heap/" + std::to_string( n ), n, [&] {
+		build( nullptr );
+	} );
+	r.run( "arena/build_screen/monotonic/" + std::to_string( n ), n, [&] {
+		musket::widget_arena arena{ musket::arena_kind::monotonic, n * 512 };
+		build( arena );
+	} );
+	r.run( "arena/build_screen/pooled/" + std::to_string( n ), n, [&] {
+		musket::widget_arena arena{ musket::arena_kind::pooled };
+		build( arena );
+	} );
+	r.run( "arena/build_screen/window/" + std::to_string( n ), n, [&] {
+		auto const arena = std::make_shared< musket::widget_arena >( musket::arena_kind::monotonic, n * 512 );
+		wnd.set_arena( arena );
+		{
+			musket::arena_scope scope{ *arena };
+			std::vector< musket::widget< cell > > cells;
+			cells.reserve( n );
+			for( std::size_t i = 0; i < n; ++i ) {
+				cells.emplace_back( cell_rect( i ) );
+				wnd.attach_widget( cells.back() );
+			}
+			detach_all( cells );
+		}
+		wnd.set_arena( nullptr );
+	} );
+}
+
+void bench_style(bench::runner& r, musket::window& wnd)
+{
+	constexpr std::size_t batch = 1000;
+
+	r.run( "style/intern_default", batch, [&] {
+		for( std::size_t i = 0; i < batch; ++i ) {
+			musket::shared_style< musket::button_style > s{ musket::deref_style< musket::button >( std::optional< musket::button_style >{}, musket::button_state::idle ) };
+		}
+	} );
+
+	r.run( "style/intern_unique", batch, [&] {
+		std::vector< musket::shared_style< musket::button_style > > styles;
+		styles.reserve( batch );
+		for( std::size_t i = 0; i < batch; ++i ) {
+			auto const v = static_cast< float >( i ) / batch;
+			styles.emplace_back( musket::button_style{ musket::rgba_color_t{ v, v, v, 1.0f } } );
+		}
+	} );
+
+	r.run( "style/recreated_target", batch, [&] {
+		for( std::size_t i = 0; i < batch; ++i ) {
+			musket::style_data_t< musket::button_style > data{ musket::deref_style< musket::button >( std::optional< musket::button_style >{}, musket::button_state::idle ) };
+			data.recreated_target( wnd.render_target() );
+		}
+	} );
+
+	if( !r.enabled( "style/memory/" ) ) {
+		return;
+	}
+
+	constexpr std::size_t n = 2000;
+	std::vector< musket::widget< musket::button > > buttons;
+	buttons.reserve( n );
+	for( std::size_t i = 0; i < n; ++i ) {
+		buttons.emplace_back( cell_rect( i ), std::to_string( i ) );
+	}
+
+	auto const report = musket::style_memory_usage< musket::button_style >();
+	r.record( "style/memory/per_button/" + std::to_string( n ), sizeof( musket::button ) + static_cast< double >( report.memory_usage ) / n, "B" );
+	r.record( "style/memory/unshared_states/button", 3.0 * sizeof( musket::style_data_t< musket::button_style > ), "B" );
+	r.record( "style/memory/button_style", sizeof( musket::button_style ), "B" );
+}
+
+void bench_text(bench::runner& r)
+{
+	constexpr std::size_t batch = 100;
+	auto const tf = musket::deref_text_format( {} );
+
+	r.run( "text/create_format", batch, [&] {
+		for( std::size_t i = 0; i < batch; ++i ) {
+			musket::create_text_format( tf );
+		}
+	} );
+
+	auto const format = musket::create_text_format( tf );
+	spirea::rect_t< float > const rc = { { 0.0f, 0.0f }, { 200.0f, 20.0f } };
+
+	r.run( "text/create_layout", batch, [&] {
+		for( std::size_t i = 0; i < batch; ++i ) {
+			musket::create_text_layout( format, rc, "The quick brown fox jumps over the lazy dog" );
+		}
+	} );
+
+	r.run( "text/prepare_texts_parallel", batch, [&] {
+		std::vector< musket::text_request > reqs;
+		for( std::size_t i = 0; i < batch; ++i ) {
+			reqs.push_back( musket::button::request_text( rc, std::to_string( i ) ) );
+		}
+		musket::prepare_texts( reqs );
+	} );
+}
+
+void bench_paint(bench::runner& r, musket::window& wnd)
+{
+	constexpr std::size_t frames = 10;
+	auto frame = wnd.render_to_bitmap();
+
+	for( std::size_t n : { 1, 100, 2000, 10000 } ) {
+		if( !r.enabled( "paint/" ) ) {
+			return;
+		}
+
+		std::vector< musket::text_request > reqs;
+		for( std::size_t i = 0; i < n; ++i ) {
+			reqs.push_back( musket::button::request_text( cell_rect( i ), std::to_string( i ) ) );
+		}
+		auto texts = musket::prepare_texts( reqs );
+
+		std::vector< musket::widget< musket::button > > buttons;
+		buttons.reserve( n );
+		for( std::size_t i = 0; i < n; ++i ) {
+			buttons.emplace_back( cell_rect( i ), std::move( texts[i] ) );
+			wnd.attach_widget( buttons.back() );
+		}
+
+		r.run( "paint/full_frame/" + std::to_string( n ), frames, [&] {
+			for( std::size_t i = 0; i < frames; ++i ) {
+				wnd.redraw();
+				wnd.render_to_bitmap( frame.view() );
+			}
+		} );
+
+		detach_all( buttons );
+	}
+}
+
+void bench_startup(bench::runner& r, musket::window& wnd)
+{
+	constexpr std::size_t n = 2000;
+	auto frame = wnd.render_to_bitmap();
+
+	auto const finish = [&](std::vector< musket::widget< musket::button > >& buttons) {
+		wnd.redraw();
+		wnd.render_to_bitmap( frame.view() );
+		detach_all( buttons );
+	};
+
+	r.run( "startup/sequential/" + std::to_string( n ), n, [&] {
+		std::vector< musket::widget< musket::button > > buttons;
+		buttons.reserve( n );
+		for( std::size_t i = 0; i < n; ++i ) {
+			buttons.emplace_back( cell_rect( i ), std::to_string( i ) );
+			wnd.attach_widget( buttons.back() );
+		}
+		finish( buttons );
+	} );
+
+	r.run( "startup/prepare_texts/" + std::to_string( n ), n, [&] {
+		std::vector< musket::text_request > reqs;
+		reqs.reserve( n );
+		for( std::size_t i = 0; i < n; ++i ) {
+			reqs.push_back( musket::button::request_text( cell_rect( i ), std::to_string( i ) ) );
+		}
+		auto texts = musket::prepare_texts( reqs );
+
+		std::vector< musket::widget< musket::button > > buttons;
+		buttons.reserve( n );
+		for( std::size_t i = 0; i < n; ++i ) {
+			buttons.emplace_back( cell_rect( i ), std::move( texts[i] ) );
+			wnd.attach_widget( buttons.back() );
+		}
+		finish( buttons );
+	} );
+}
+
+void bench_hidden(bench::runner& r, musket::window& wnd)
+{
+	constexpr std::size_t n = 10000;
+	constexpr std::size_t visible = 100;
+
+	if( !r.enabled( "hidden/" ) ) {
+		return;
+	}
+
+	std::vector< musket::text_request > reqs;
+	for( std::size_t i = 0; i < n; ++i ) {
+		reqs.push_back( musket::button::request_text( cell_rect( i ), std::to_string( i ) ) );
+	}
+	auto texts = musket::prepare_texts( reqs );
+
+	std::vector< musket::widget< musket::button > > buttons;
+	buttons.reserve( n );
+	for( std::size_t i = 0; i < n; ++i ) {
+		buttons.emplace_back( cell_rect( i ), std::move( texts[i] ) );
+		if( i >= visible ) {
+			buttons.back()->hide();
+		}
+	}
+
+	auto frame = wnd.render_to_bitmap();
+	auto const suffix = "/" + std::to_string( n );
+
+	r.run( "hidden/attach_first_frame" + suffix, n, [&] {
+		for( auto& b : buttons ) {
+			wnd.attach_widget( b );
+		}
+		wnd.redraw();
+		wnd.render_to_bitmap( frame.view() );
+		for( auto& b : buttons ) {
+			musket::detach( b );
+		}
+	} );
+
+	for( auto& b : buttons ) {
+		wnd.attach_widget( b );
+	}
+	wnd.redraw();
+	wnd.render_to_bitmap( frame.view() );
+
+	// render_to on a foreign target bumps the generation the same way a device loss does
+	musket::detail::offscreen_target lost{ wnd.client_area_size().width(), wnd.client_area_size().height() };
+	r.run( "hidden/device_loss_recovery" + suffix, 1, [&] {
+		wnd.render_to( lost.render_target() );
+	} );
+
+	detach_all( buttons );
+}
+
+void bench_scroll_view(bench::runner& r, musket::window& wnd)
+{
+	constexpr std::size_t rows = 100000;
+	constexpr std::size_t frames = 50;
+	constexpr float row_height = 20.0f;
+
+	if( !r.enabled( "scroll_view/" ) ) {
+		return;
+	}
+
+	auto const rc = wnd.client_area_size();
+
+	std::vector< spirea::rect_t< float > > rects;
+	std::vector< musket::text_request > reqs;
+	rects.reserve( rows );
+	reqs.reserve( rows );
+	for( std::size_t i = 0; i < rows; ++i ) {
+		rects.push_back( { { 10.0f, row_height * i }, { rc.width() - 20.0f, row_height } } );
+		reqs.push_back( musket::label::request_text( rects.back(), "row " + std::to_string( i ) ) );
+	}
+	auto texts = musket::prepare_texts( reqs );
+
+	musket::widget< musket::scroll_view< musket::axis_flag::vertical > > view = { rc, row_height * rows };
+	std::vector< musket::widget< musket::label > > labels;
+	labels.reserve( rows );
+	for( std::size_t i = 0; i < rows; ++i ) {
+		labels.emplace_back( rects[i], std::move( texts[i] ) );
+		view->attach_widget( labels.back() );
+	}
+	wnd.attach_widget( view );
+
+	auto frame = wnd.render_to_bitmap();
+	auto const max_offset = view->extent() - rc.height();
+	auto const suffix = "/" + std::to_string( rows );
+
+	auto scroll = [&](float step) {
+		float offset = view->offset();
+		for( std::size_t i = 0; i < frames; ++i ) {
+			offset = offset + step > max_offset ? 0.0f : offset + step;
+			view->scroll_to( offset );
+			wnd.redraw( view->size() );
+			wnd.render_to_bitmap( frame.view() );
+		}
+	};
+
+	r.run( "scroll_view/scroll_step" + suffix, frames, [&] {
+		scroll( 3.0f );
+	} );
+	r.run( "scroll_view/scroll_page" + suffix, frames, [&] {
+		scroll( rc.height() );
+	} );
+
+	musket::detach( view );
+}
+
+void bench_data_grid(bench::runner& r, musket::window& wnd)
+{
+	constexpr std::size_t rows = 1000000;
+	constexpr std::size_t columns = 200;
+	constexpr std::size_t frames = 20;
+
+	if( !r.enabled( "data_grid/" ) ) {
+		return;
+	}
+
+	auto const memory = private_bytes();
+
+	musket::widget< musket::data_grid > grid = {
+		wnd.client_area_size(), rows, columns,
+		[](std::size_t row, std::size_t column) {
+			return std::to_string( row ) + ":" + std::to_string( column );
+		}
+	};
+	wnd.attach_widget( grid );
+
+	auto frame = wnd.render_to_bitmap();
+	auto const suffix = "/" + std::to_string( rows ) + "x" + std::to_string( columns );
+
+	auto scroll = [&](std::size_t row_step, float x_step) {
+		for( std::size_t i = 0; i < frames; ++i ) {
+			auto const row = grid->first_row() + row_step;
+			grid->scroll_to( row >= rows / 2 ? 0 : row, x_step * static_cast< float >( i ) );
+			wnd.render_to_bitmap( frame.view() );
+		}
+	};
+
+	r.run( "data_grid/scroll_row" + suffix, frames, [&] {
+		scroll( 1, 0.0f );
+	} );
+	r.run( "data_grid/scroll_page" + suffix, frames, [&] {
+		scroll( 40, 0.0f );
+	} );
+	r.run( "data_grid/scroll_column" + suffix, frames, [&] {
+		scroll( 0, 80.0f );
+	} );
+
+	auto const used = private_bytes();
+	r.record( "data_grid/memory" + suffix, static_cast< double >( used > memory ? used - memory : 0 ) / 1024.0, "KiB" );
+	r.record( "data_grid/cached_cells" + suffix, static_cast< double >( grid->cached_cells() ), "cells" );
+
+	musket::detach( grid );
+}
+
+void bench_plot(bench::runner& r, musket::window& wnd)
+{
+	constexpr std::size_t samples_per_ms = 1000;
+	constexpr std::size_t frames = 20;
+
+	if( !r.enabled( "plot/" ) ) {
+		return;
+	}
+
+	musket::widget< musket::plot > chart = { wnd.client_area_size() };
+	wnd.attach_widget( chart );
+
+	auto frame = wnd.render_to_bitmap();
+	auto const src = chart->source();
+
+	{
+		background_thread producer{ [src](std::atomic< bool > const& stop) {
+			auto next = std::chrono::steady_clock::now();
+			std::size_t n = 0;
+			while( !stop.load( std::memory_order_relaxed ) ) {
+				for( std::size_t i = 0; i < samples_per_ms; ++i, ++n ) {
+					src.push( std::sin( static_cast< float >( n ) * 0.001f ) );
+				}
+				next += std::chrono::milliseconds{ 1 };
+				std::this_thread::sleep_until( next );
+			}
+		} };
+
+		r.run( "plot/frame_at_1M_samples_per_s", frames, [&] {
+			for( std::size_t i = 0; i < frames; ++i ) {
+				wnd.render_to_bitmap( frame.view() );
+			}
+		} );
+	}
+
+	r.record( "plot/dropped_at_1M_samples_per_s", static_cast< double >( src.dropped() ), "samples" );
+
+	musket::detach( chart );
+}
+
+void bench_text_view(bench::runner& r, musket::window& wnd)
+{
+	constexpr std::size_t file_size = std::size_t{ 256 } << 20;
+
+	if( !r.enabled( "text_view/" ) ) {
+		return;
+	}
+
+	auto const path = ( std::filesystem::temp_directory_path() / "musket_bench_text_view.log" ).string();
+	{
+		std::ofstream ofs{ path, std::ios::binary };
+		std::string line;
+		for( std::size_t written = 0, i = 0; written < file_size; written += line.size(), ++i ) {
+			line = std::to_string( i ) + " the quick brown fox jumps over the lazy dog\n";
+			ofs << line;
+		}
+	}
+
+	{
+		musket::widget< musket::text_view > view = { wnd.client_area_size(), path };
+		wnd.attach_widget( view );
+
+		auto frame = wnd.render_to_bitmap();
+		auto const lines = static_cast< std::uint64_t >( wnd.client_area_size().height() / musket::text_view_property{}.line_height ) + 1;
+
+		r.run( "text_view/open_first_screen/256MiB", 1, [&] {
+			view->open( path );
+			while( view->size_of_lines() < lines && !view->is_indexed() ) {
+				std::this_thread::yield();
+			}
+			wnd.redraw();
+			wnd.render_to_bitmap( frame.view() );
+		} );
+
+		while( !view->is_indexed() ) {
+			std::this_thread::sleep_for( std::chrono::milliseconds{ 1 } );
+		}
+		r.record( "text_view/index_memory/256MiB", static_cast< double >( view->index_memory_usage() ) / 1024.0, "KiB" );
+
+		musket::detach( view );
+	}
+
+	std::error_code ec;
+	std::filesystem::remove( path, ec );
+}
+
+void bench_text_editor(bench::runner& r, musket::window& wnd)
+{
+	constexpr std::size_t document_size = std::size_t{ 50 } << 20;
+
+	if( !r.enabled( "text_editor/" ) ) {
+		return;
+	}
+
+	std::string doc;
+	doc.reserve( document_size + 128 );
+	for( std::size_t i = 0; doc.size() < document_size; ++i ) {
+		doc += std::to_string( i ) + " lorem ipsum dolor sit amet, consectetur adipiscing elit\n";
+	}
+
+	musket::text_editor_property prop;
+	prop.caret_blink = std::chrono::milliseconds{ 0 };
+
+	musket::widget< musket::text_editor > editor = { wnd.client_area_size(), doc, prop };
+	wnd.attach_widget( editor );
+
+	wnd.dispatch_input( mouse_input( musket::input_kind::mouse_button_pressed, 20, 20 ) );
+	wnd.dispatch_input( mouse_input( musket::input_kind::mouse_button_released, 20, 20 ) );
+	editor->set_caret( doc.size() / 2 );
+
+	std::vector< musket::input_record > script;
+	for( char32_t c : std::u32string_view{ U"hello, world\b\b\b\b\bworld\r" } ) {
+		musket::input_record k;
+		k.kind = musket::input_kind::char_input;
+		k.code = static_cast< std::uint32_t >( c );
+		script.push_back( k );
+	}
+
+	auto frame = wnd.render_to_bitmap();
+
+	r.run( "text_editor/keystroke_to_paint/50MiB", script.size(), [&] {
+		for( auto const& k : script ) {
+			wnd.dispatch_input( k );
+			wnd.render_to_bitmap( frame.view() );
+		}
+	} );
+
+	musket::detach( editor );
+}
+
+void bench_post(bench::runner& r)
+{
+	constexpr std::size_t per_producer = 100000;
+
+	if( !r.enabled( "post/" ) ) {
+		return;
+	}
+
+	musket::window wnd = {
+		spirea::rect_t< float >{ { 0, 0 }, { 320, 240 } },
+		"musket_bench_post"
+	};
+
+	for( std::size_t producers : { 1, 2, 4, 8 } ) {
+		auto const total = producers * per_producer;
+
+		r.run( "post/throughput/" + std::to_string( producers ), total, [&] {
+			std::size_t done = 0;
+
+			std::vector< std::thread > threads;
+			for( std::size_t i = 0; i < producers; ++i ) {
+				threads.emplace_back( [&wnd, &done] {
+					for( std::size_t j = 0; j < per_producer; ++j ) {
+						while( !wnd.post( [&done] { ++done; } ) ) {
+							std::this_thread::yield();
+						}
+					}
+				} );
+			}
+
+			while( done < total ) {
+				MsgWaitForMultipleObjectsEx( 0, nullptr, 1, QS_ALLINPUT, MWMO_INPUTAVAILABLE );
+				pump_messages();
+				musket::detail::retry_failed_wakes();
+			}
+
+			for( auto& t : threads ) {
+				t.join();
+			}
+		} );
+	}
+
+	wnd.close();
+	pump_messages();
+}
+
+void bench_idle(bench::runner& r)
+{
+	constexpr std::chrono::milliseconds duration{ 2000 };
+
+	if( !r.enabled( "idle/" ) ) {
+		return;
+	}
+
+	musket::window wnd = {
+		spirea::rect_t< float >{ { 0, 0 }, { 320, 240 } },
+		"musket_bench_idle"
+	};
+	wnd.show();
+	pump_messages();
+
+	wnd.set_timer( duration, [](musket::window&) {
+		PostQuitMessage( 0 );
+	} );
+
+	auto const cpu = process_cpu_time();
+	auto const t0 = std::chrono::steady_clock::now();
+	musket::event_loop();
+	auto const wall = std::chrono::duration< double >( std::chrono::steady_clock::now() - t0 ).count();
+
+	r.record( "idle/event_loop_cpu", static_cast< double >( ( process_cpu_time() - cpu ).count() ) / wall, "us/s" );
+
+	wnd.close();
+	pump_messages();
+}
+
+int main(int argc, char** argv)
+{
+	try {
+		auto const opt = bench::parse_options( argc, argv );
+		if( !opt.verify_dir.empty() ) {
+			return bench::verify( opt );
+		}
+
+		bench::runner r{ opt };
+
+		bench_idle( r );
+		bench_post( r );
+
+		musket::window wnd = {
+			spirea::rect_t< float >{ { 0, 0 }, { 1000, 800 } },
+			"musket_bench",
+			musket::rgba_color_t{ 0.2f, 0.2f, 0.2f, 0.0f },
+			musket::window_type::offscreen{}
+		};
+
+		bench_dispatch( r, wnd );
+		bench_connect( r, wnd );
+		bench_arena( r, wnd );
+		bench_style( r, wnd );
+		bench_text( r );
+		bench_paint( r, wnd );
+		bench_startup( r, wnd );
+		bench_hidden( r, wnd );
+		bench_scroll_view( r, wnd );
+		bench_data_grid( r, wnd );
+		bench_plot( r, wnd );
+		bench_text_view( r, wnd );
+		bench_text_editor( r, wnd );
+
+		return r.finish();
+	}
+	catch( std::exception const& e ) {
+		std::cerr << e.what() << std::endl;
+	}
+	catch( ... ) {
+		std::cerr << "unknown error" << std::endl;
+	}
+	return 2;
+}
\ No newline at end of file
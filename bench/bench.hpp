@@ -0,0 +1,250 @@
+//--------------------------------------------------------
+// musket/bench/bench.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_BENCH_BENCH_HPP_
+#define MUSKET_BENCH_BENCH_HPP_
+
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <string_view>
+
+namespace bench {
+
+	inline std::atomic< std::size_t > allocation_count{ 0 };
+
+	struct result
+	{
+		std::string name;
+		std::size_t ops = 0;
+		std::size_t samples = 0;
+		double ns_per_op = 0.0;
+		double min_ns_per_op = 0.0;
+		std::string unit = "ns/op";
+	};
+
+	struct options
+	{
+		std::string filter;
+		std::string json_path;
+		std::string baseline_path;
+		double threshold = 0.1;
+		std::chrono::milliseconds min_time{ 200 };
+		std::string verify_dir;
+		bool update_goldens = false;
+	};
+
+	inline options parse_options(int argc, char** argv)
+	{
+		options opt;
+		for( int i = 1; i < argc; ++i ) {
+			std::string_view const arg = argv[i];
+			auto const next = [&]() -> std::string {
+				return i + 1 < argc ? argv[++i] : "";
+			};
+
+			if( arg == "--filter" ) {
+				opt.filter = next();
+			}
+			else if( arg == "--json" ) {
+				opt.json_path = next();
+			}
+			else if( arg == "--baseline" ) {
+				opt.baseline_path = next();
+			}
+			else if( arg == "--threshold" ) {
+				opt.threshold = std::stod( next() ) / 100.0;
+			}
+			else if( arg == "--min-time" ) {
+				opt.min_time = std::chrono::milliseconds{ std::stol( next() ) };
+			}
+			else if( arg == "--verify" ) {
+				opt.verify_dir = next();
+			}
+			else if( arg == "--update-goldens" ) {
+				opt.update_goldens = true;
+			}
+			else {
+				std::cerr << "usage: musket_bench [--filter <substr>] [--json <path>] [--baseline <path>] [--threshold <percent>] [--min-time <ms>] [--verify <dir> [--update-goldens]]" << std::endl;
+				std::exit( 2 );
+			}
+		}
+		return opt;
+	}
+
+	inline std::string to_json(std::vector< result > const& results)
+	{
+		std::ostringstream oss;
+		oss << "[\n";
+		for( std::size_t i = 0; i < results.size(); ++i ) {
+			auto const& r = results[i];
+			oss << "{\"name\":\"" << r.name << "\",\"ops\":" << r.ops << ",\"samples\":" << r.samples
+				<< ",\"ns_per_op\":" << r.ns_per_op << ",\"min_ns_per_op\":" << r.min_ns_per_op << ",\"unit\":\"" << r.unit << "\"}"
+				<< ( i + 1 < results.size() ? ",\n" : "\n" );
+		}
+		oss << "]\n";
+		return oss.str();
+	}
+
+	inline std::vector< result > load_results(std::string const& path)
+	{
+		std::vector< result > results;
+		std::ifstream ifs{ path };
+		std::string line;
+		while( std::getline( ifs, line ) ) {
+			auto const field = [&](std::string_view key) -> std::string {
+				auto const k = "\"" + std::string{ key } + "\":";
+				auto const p = line.find( k );
+				if( p == std::string::npos ) {
+					return {};
+				}
+				auto first = p + k.size();
+				if( line[first] == '"' ) {
+					++first;
+					return line.substr( first, line.find( '"', first ) - first );
+				}
+				return line.substr( first, line.find_first_of( ",}", first ) - first );
+			};
+
+			auto const name = field( "name" );
+			auto const ns = field( "ns_per_op" );
+			if( name.empty() || ns.empty() ) {
+				continue;
+			}
+
+			result r;
+			r.name = name;
+			r.ns_per_op = std::stod( ns );
+			results.push_back( r );
+		}
+		return results;
+	}
+
+	class runner
+	{
+		using clock = std::chrono::steady_clock;
+
+		options opt_;
+		std::vector< result > results_;
+
+	public:
+		explicit runner(options const& opt) :
+			opt_{ opt }
+		{ }
+
+		bool enabled(std::string_view name) const noexcept
+		{
+			return opt_.filter.empty() || name.find( opt_.filter ) != std::string_view::npos;
+		}
+
+		template <typename F>
+		void run(std::string const& name, std::size_t ops, F&& f)
+		{
+			if( !enabled( name ) ) {
+				return;
+			}
+
+			f();
+
+			std::vector< double > samples;
+			auto const start = clock::now();
+			while( samples.size() < 5 || ( clock::now() - start < opt_.min_time && samples.size() < 100000 ) ) {
+				auto const t0 = clock::now();
+				f();
+				auto const t1 = clock::now();
+				samples.push_back( std::chrono::duration< double, std::nano >( t1 - t0 ).count() / ops );
+			}
+			std::sort( samples.begin(), samples.end() );
+
+			result r;
+			r.name = name;
+			r.ops = ops;
+			r.samples = samples.size();
+			r.ns_per_op = samples[samples.size() / 2];
+			r.min_ns_per_op = samples.front();
+			results_.push_back( r );
+
+			std::printf( "%-48s %14.1f ns/op %14.1f min %8zu samples\n", r.name.c_str(), r.ns_per_op, r.min_ns_per_op, r.samples );
+			std::fflush( stdout );
+		}
+
+		void record(std::string const& name, double value, std::string_view unit)
+		{
+			if( !enabled( name ) ) {
+				return;
+			}
+
+			result r;
+			r.name = name;
+			r.ops = 1;
+			r.samples = 1;
+			r.ns_per_op = value;
+			r.min_ns_per_op = value;
+			r.unit = unit;
+			results_.push_back( r );
+
+			std::printf( "%-48s %14.1f %s\n", r.name.c_str(), value, r.unit.c_str() );
+			std::fflush( stdout );
+		}
+
+		std::vector< result > const& results() const noexcept
+		{
+			return results_;
+		}
+
+		int finish() const
+		{
+			if( !opt_.json_path.empty() ) {
+				std::ofstream ofs{ opt_.json_path };
+				ofs << to_json( results_ );
+				if( !ofs ) {
+					std::cerr << "failed to write " << opt_.json_path << std::endl;
+					return 2;
+				}
+			}
+
+			if( opt_.baseline_path.empty() ) {
+				return 0;
+			}
+
+			auto const baseline = load_results( opt_.baseline_path );
+			if( baseline.empty() ) {
+				std::cerr << "no results in baseline " << opt_.baseline_path << std::endl;
+				return 2;
+			}
+
+			std::size_t regressions = 0;
+			for( auto const& r : results_ ) {
+				auto const b = std::find_if( baseline.begin(), baseline.end(), [&](auto const& x) { return x.name == r.name; } );
+				if( b == baseline.end() || b->ns_per_op <= 0.0 ) {
+					continue;
+				}
+
+				auto const ratio = r.ns_per_op / b->ns_per_op;
+				if( ratio > 1.0 + opt_.threshold ) {
+					std::printf( "REGRESSION %-37s %14.1f -> %.1f %s (%+.1f%%)\n", r.name.c_str(), b->ns_per_op, r.ns_per_op, r.unit.c_str(), ( ratio - 1.0 ) * 100.0 );
+					++regressions;
+				}
+			}
+
+			std::printf( "%zu regression(s) against %s\n", regressions, opt_.baseline_path.c_str() );
+			return regressions > 0 ? 1 : 0;
+		}
+	};
+
+} // namespace bench
+
+#endif // MUSKET_BENCH_BENCH_HPP_
\ No newline at end of file
@@ -0,0 +1,497 @@
+//--------------------------------------------------------
+// musket/bench/verify.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_BENCH_VERIFY_HPP_
+#define MUSKET_BENCH_VERIFY_HPP_
+
+#include <tuple>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <functional>
+#include <musket.hpp>
+#include "bench.hpp"
+
+namespace bench {
+
+	struct frame_metrics
+	{
+		std::uint64_t draws = 0;
+		float invalidated_area = 0.0f;
+		std::size_t allocations = 0;
+	};
+
+	struct screen
+	{
+		std::string name;
+		std::function< std::shared_ptr< void > (musket::window&) > build;
+		std::function< std::vector< musket::input_record > (musket::window&) > script;
+	};
+
+	inline musket::input_record mouse(musket::input_kind kind, std::int32_t x, std::int32_t y, musket::mouse_button buttons = musket::mouse_button::none) noexcept
+	{
+		musket::input_record r;
+		r.kind = kind;
+		r.button = kind == musket::input_kind::mouse_moved ? musket::mouse_button::none : musket::mouse_button::left;
+		r.buttons = buttons;
+		r.position = { x, y };
+		return r;
+	}
+
+	inline std::vector< musket::input_record > drag(std::int32_t x0, std::int32_t y0, std::int32_t x1, std::int32_t y1)
+	{
+		using musket::input_kind;
+		return {
+			mouse( input_kind::mouse_moved, x0, y0 ),
+			mouse( input_kind::mouse_button_pressed, x0, y0, musket::mouse_button::left ),
+			mouse( input_kind::mouse_moved, ( x0 + x1 ) / 2, ( y0 + y1 ) / 2, musket::mouse_button::left ),
+			mouse( input_kind::mouse_moved, x1, y1, musket::mouse_button::left ),
+			mouse( input_kind::mouse_button_released, x1, y1 ),
+			mouse( input_kind::mouse_moved, 1, 1 ),
+		};
+	}
+
+	inline std::vector< screen > example_screens()
+	{
+		std::vector< screen > screens;
+
+		screens.push_back( {
+			"hello_world",
+			[](musket::window& wnd) -> std::shared_ptr< void > {
+				musket::button_property prop;
+				prop.transition = std::chrono::milliseconds{ 0 };
+
+				musket::widget< musket::button > btn = {
+					spirea::rect_t< float >{ { 110.0f, 150.0f }, { 100.0f, 30.0f } },
+					"Push", prop
+				};
+				musket::widget< musket::label > lbl = {
+					spirea::rect_t< float >{ { 60.0f, 60.0f }, { 200.0f, 30.0f } },
+					"hello, world!"
+				};
+				lbl->hide();
+
+				btn->connect( musket::button_event::pressed{}, [lbl](spirea::point_t< std::int32_t > const&) mutable {
+					musket::switch_visibility( lbl );
+				} );
+
+				wnd.attach_widget( btn );
+				wnd.attach_widget( lbl );
+				return std::make_shared< std::tuple< decltype( btn ), decltype( lbl ) > >( btn, lbl );
+			},
+			[](musket::window&) {
+				return drag( 160, 165, 160, 165 );
+			}
+		} );
+
+		screens.push_back( {
+			"scroll_bar",
+			[](musket::window& wnd) -> std::shared_ptr< void > {
+				musket::text_format tf;
+				tf.size = 24.0f;
+
+				musket::scroll_bar_property prop;
+				prop.transition = std::chrono::milliseconds{ 0 };
+
+				auto const rc = wnd.client_area_size();
+
+				musket::widget< musket::label > lbl = {
+					spirea::rect_t< float >{ { 40.0f, 50.f }, { 200.0f, 30.0f } },
+					"0, 3", musket::label_property{ tf }
+				};
+				musket::widget< musket::label > hlbl = {
+					spirea::rect_t< float >{ { 40.0f, 100.f }, { 200.0f, 30.0f } },
+					"0, 3", musket::label_property{ tf }
+				};
+				musket::widget< musket::scroll_bar< musket::axis_flag::vertical > > scroll = {
+					spirea::rect_t< float >{ { rc.right - 20.0f, 0.0f }, { 20.0f, rc.bottom } },
+					3u, 100u, prop
+				};
+				musket::widget< musket::scroll_bar< musket::axis_flag::horizontal > > hscroll = {
+					spirea::rect_t< float >{ { 0.0f, rc.bottom - 20.0f }, { rc.right - 22.0f, 20.0f } },
+					3u, 100u, prop
+				};
+
+				scroll->connect( musket::scroll_bar_event::scroll{}, [lbl](std::uint32_t lower, std::uint32_t upper) mutable {
+					lbl->set_text( std::to_string( lower ) + ", " + std::to_string( upper ) );
+				} );
+				hscroll->connect( musket::scroll_bar_event::scroll{}, [hlbl](std::uint32_t lower, std::uint32_t upper) mutable {
+					hlbl->set_text( std::to_string( lower ) + ", " + std::to_string( upper ) );
+				} );
+
+				wnd.attach_widget( lbl );
+				wnd.attach_widget( hlbl );
+				wnd.attach_widget( scroll );
+				wnd.attach_widget( hscroll );
+				return std::make_shared< std::tuple< decltype( lbl ), decltype( hlbl ), decltype( scroll ), decltype( hscroll ) > >( lbl, hlbl, scroll, hscroll );
+			},
+			[](musket::window& wnd) {
+				auto const rc = wnd.client_area_size();
+				auto const x = static_cast< std::int32_t >( rc.right - 10.0f );
+				auto const y = static_cast< std::int32_t >( rc.bottom - 10.0f );
+				auto v = drag( x, 30, x, 120 );
+				auto const h = drag( 20, y, 140, y );
+				v.insert( v.end(), h.begin(), h.end() );
+				return v;
+			}
+		} );
+
+		screens.push_back( {
+			"attributes",
+			[](musket::window& wnd) -> std::shared_ptr< void > {
+				musket::text_format tf;
+				tf.size = 18.0f;
+
+				musket::scroll_bar_property prop;
+				prop.transition = std::chrono::milliseconds{ 0 };
+
+				auto const rc = wnd.client_area_size();
+
+				musket::widget< musket::auto_resizer< musket::label > > lbl = {
+					spirea::rect_t< float >{ { 20.0f, 30.0f }, { rc.width() - 50.0f, rc.height() - 60.0f } },
+					"AutoResize",
+					musket::label_property{
+						tf,
+						musket::label_style{
+							musket::rgba_color_t{ 0.2f, 0.2f, 0.2f, 1.0f },
+							musket::edge_property{ { 0.95f, 0.95f, 0.0f, 1.0f } },
+							musket::rgba_color_t{ 1.0f, 1.0f, 1.0f, 1.0f }
+						},
+					}
+				};
+				musket::widget< musket::auto_scaling_scroll_bar< musket::axis_flag::vertical > > scroll_bar = {
+					spirea::rect_t< float >{ { rc.right - 20.0f, 0.0f }, { 20.0f, rc.bottom } },
+					5u, 100u, prop
+				};
+
+				wnd.attach_widget( lbl );
+				wnd.attach_widget( scroll_bar );
+				return std::make_shared< std::tuple< decltype( lbl ), decltype( scroll_bar ) > >( lbl, scroll_bar );
+			},
+			[](musket::window& wnd) {
+				auto const rc = wnd.client_area_size();
+				auto const x = static_cast< std::int32_t >( rc.right - 10.0f );
+				return drag( x, 20, x, 150 );
+			}
+		} );
+
+		screens.push_back( {
+			"static_panel",
+			[](musket::window& wnd) -> std::shared_ptr< void > {
+				using panel_type = musket::static_panel< musket::button, musket::button, musket::label >;
+
+				musket::widget< panel_type > panel = {
+					wnd.client_area_size(),
+					musket::button{ spirea::rect_t< float >{ { 50.0f, 150.0f }, { 100.0f, 30.0f } }, "Show" },
+					musket::button{ spirea::rect_t< float >{ { 170.0f, 150.0f }, { 100.0f, 30.0f } }, "Hide" },
+					musket::label{ spirea::rect_t< float >{ { 60.0f, 60.0f }, { 200.0f, 30.0f } }, "hello, world!" }
+				};
+
+				auto& lbl = panel->get< 2 >();
+				lbl.hide();
+				panel->get< 0 >().connect( musket::button_event::pressed{}, [&lbl](spirea::point_t< std::int32_t > const&) {
+					lbl.show();
+				} );
+				panel->get< 1 >().connect( musket::button_event::pressed{}, [&lbl](spirea::point_t< std::int32_t > const&) {
+					lbl.hide();
+				} );
+
+				wnd.attach_widget( panel );
+				return std::make_shared< decltype( panel ) >( panel );
+			},
+			[](musket::window&) {
+				using musket::input_kind;
+				auto v = drag( 100, 165, 100, 165 );
+				auto const h = drag( 220, 165, 220, 165 );
+				v.insert( v.end(), h.begin(), h.end() );
+				v.push_back( mouse( input_kind::mouse_moved, 100, 165 ) );
+				v.push_back( mouse( input_kind::mouse_moved, 220, 165 ) );
+				return v;
+			}
+		} );
+
+		screens.push_back( {
+			"defaults",
+			[](musket::window& wnd) -> std::shared_ptr< void > {
+				auto const rc = wnd.client_area_size();
+
+				musket::widget< musket::button > btn = {
+					spirea::rect_t< float >{ { 60.0f, 150.0f }, { 100.0f, 30.0f } },
+					"Push"
+				};
+				musket::widget< musket::label > lbl = {
+					spirea::rect_t< float >{ { 20.0f, 60.0f }, { 200.0f, 30.0f } },
+					"hello, world!"
+				};
+				musket::widget< musket::scroll_bar< musket::axis_flag::vertical > > scroll = {
+					spirea::rect_t< float >{ { rc.right - 20.0f, 0.0f }, { 20.0f, rc.bottom } },
+					3u, 100u
+				};
+				lbl->hide();
+
+				btn->connect( musket::button_event::pressed{}, [lbl](spirea::point_t< std::int32_t > const&) mutable {
+					musket::switch_visibility( lbl );
+				} );
+
+				wnd.attach_widget( btn );
+				wnd.attach_widget( lbl );
+				wnd.attach_widget( scroll );
+				return std::make_shared< std::tuple< decltype( btn ), decltype( lbl ), decltype( scroll ) > >( btn, lbl, scroll );
+			},
+			[](musket::window& wnd) {
+				auto const x = static_cast< std::int32_t >( wnd.client_area_size().right - 10.0f );
+				auto v = drag( 110, 165, 110, 165 );
+				auto const s = drag( x, 30, x, 120 );
+				v.insert( v.end(), s.begin(), s.end() );
+				return v;
+			}
+		} );
+
+		return screens;
+	}
+
+	inline musket::bitmap settle(musket::window& wnd, musket::bitmap frame)
+	{
+		auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds{ 2 };
+		while( wnd.take_invalidations().requests > 0 && std::chrono::steady_clock::now() < deadline ) {
+			std::this_thread::sleep_for( std::chrono::milliseconds{ 16 } );
+			frame = wnd.render_to_bitmap();
+		}
+		return frame;
+	}
+
+	inline bool write_golden(std::string const& path, musket::bitmap const& bmp)
+	{
+		auto const width = bmp.width();
+		auto const height = bmp.height();
+		auto const& px = bmp.pixels();
+
+		std::ofstream ofs{ path, std::ios::binary };
+		ofs.write( reinterpret_cast< char const* >( &width ), sizeof( width ) );
+		ofs.write( reinterpret_cast< char const* >( &height ), sizeof( height ) );
+		ofs.write( reinterpret_cast< char const* >( px.data() ), static_cast< std::streamsize >( px.size() * sizeof( std::uint32_t ) ) );
+		return static_cast< bool >( ofs );
+	}
+
+	inline std::optional< std::vector< std::uint32_t > > read_golden(std::string const& path, std::uint32_t width, std::uint32_t height)
+	{
+		std::ifstream ifs{ path, std::ios::binary };
+		std::uint32_t w = 0;
+		std::uint32_t h = 0;
+		ifs.read( reinterpret_cast< char* >( &w ), sizeof( w ) );
+		ifs.read( reinterpret_cast< char* >( &h ), sizeof( h ) );
+		if( !ifs || w != width || h != height ) {
+			return std::nullopt;
+		}
+
+		std::vector< std::uint32_t > px( static_cast< std::size_t >( w ) * h );
+		ifs.read( reinterpret_cast< char* >( px.data() ), static_cast< std::streamsize >( px.size() * sizeof( std::uint32_t ) ) );
+		if( !ifs ) {
+			return std::nullopt;
+		}
+		return px;
+	}
+
+	inline std::size_t count_mismatches(std::vector< std::uint32_t > const& a, std::vector< std::uint32_t > const& b, int tolerance = 2) noexcept
+	{
+		std::size_t n = 0;
+		for( std::size_t i = 0; i < a.size(); ++i ) {
+			for( int shift = 0; shift < 32; shift += 8 ) {
+				auto const ca = static_cast< int >( ( a[i] >> shift ) & 0xff );
+				auto const cb = static_cast< int >( ( b[i] >> shift ) & 0xff );
+				if( std::abs( ca - cb ) > tolerance ) {
+					++n;
+					break;
+				}
+			}
+		}
+		return n;
+	}
+
+	inline std::vector< frame_metrics > read_budget(std::string const& path)
+	{
+		std::vector< frame_metrics > budget;
+		std::ifstream ifs{ path };
+		std::size_t step;
+		frame_metrics m;
+		while( ifs >> step >> m.draws >> m.invalidated_area >> m.allocations ) {
+			budget.push_back( m );
+		}
+		return budget;
+	}
+
+	inline bool write_budget(std::string const& path, std::vector< frame_metrics > const& metrics)
+	{
+		std::ofstream ofs{ path };
+		for( std::size_t i = 0; i < metrics.size(); ++i ) {
+			ofs << i << ' ' << metrics[i].draws << ' ' << metrics[i].invalidated_area << ' ' << metrics[i].allocations << '\n';
+		}
+		return static_cast< bool >( ofs );
+	}
+
+	inline std::uint64_t count_draws(musket::window const& wnd)
+	{
+		std::uint64_t n = 0;
+		for( auto const& t : wnd.widget_type_costs() ) {
+			n += t.draws;
+		}
+		return n;
+	}
+
+	inline std::size_t verify_screen(screen const& s, options const& opt)
+	{
+		musket::window wnd = {
+			spirea::rect_t< float >{ { 0, 0 }, { 320, 240 } },
+			s.name,
+			musket::rgba_color_t{ 0.2f, 0.2f, 0.2f, 0.0f },
+			musket::window_type::offscreen{}
+		};
+		auto const holder = s.build( wnd );
+		auto const script = s.script( wnd );
+		wnd.set_draw_profiling( true );
+
+		std::vector< frame_metrics > metrics;
+		std::vector< musket::bitmap > frames;
+		wnd.take_invalidations();
+
+		for( std::size_t step = 0; step <= script.size(); ++step ) {
+			wnd.reset_draw_profile();
+			auto const allocs = allocation_count.load();
+
+			frame_metrics m;
+			if( step > 0 ) {
+				wnd.dispatch_input( script[step - 1] );
+				m.invalidated_area = wnd.take_invalidations().area;
+			}
+			auto frame = wnd.render_to_bitmap();
+			m.draws = count_draws( wnd );
+			m.allocations = allocation_count.load() - allocs;
+
+			metrics.push_back( m );
+			frames.push_back( settle( wnd, std::move( frame ) ) );
+		}
+
+		auto const base = opt.verify_dir + "/" + s.name;
+		if( opt.update_goldens ) {
+			bool ok = write_budget( base + ".budget", metrics );
+			for( std::size_t i = 0; i < frames.size(); ++i ) {
+				ok = write_golden( base + "." + std::to_string( i ) + ".bgra", frames[i] ) && ok;
+			}
+			std::cout << s.name << ": " << ( ok ? "updated " : "FAILED to update " ) << frames.size() << " golden frame(s)" << std::endl;
+			return ok ? 0 : 1;
+		}
+
+		std::size_t failures = 0;
+		auto const budget = read_budget( base + ".budget" );
+		if( budget.size() != metrics.size() ) {
+			std::cout << s.name << ": budget has " << budget.size() << " step(s), script has " << metrics.size() << std::endl;
+			return 1;
+		}
+
+		for( std::size_t i = 0; i < frames.size(); ++i ) {
+			auto const step = s.name + "[" + std::to_string( i ) + "]";
+			auto const golden = read_golden( base + "." + std::to_string( i ) + ".bgra", frames[i].width(), frames[i].height() );
+			if( !golden ) {
+				std::cout << step << ": missing or mismatched golden" << std::endl;
+				++failures;
+			}
+			else if( auto const n = count_mismatches( frames[i].pixels(), *golden ); n > 0 ) {
+				std::cout << step << ": " << n << " pixel(s) differ from golden" << std::endl;
+				++failures;
+			}
+
+			auto const& m = metrics[i];
+			auto const& b = budget[i];
+			if( m.draws > b.draws ) {
+				std::cout << step << ": " << m.draws << " draws, budget " << b.draws << std::endl;
+				++failures;
+			}
+			if( m.invalidated_area > b.invalidated_area + 0.5f ) {
+				std::cout << step << ": invalidated " << m.invalidated_area << " DIP^2, budget " << b.invalidated_area << std::endl;
+				++failures;
+			}
+			if( m.allocations > b.allocations ) {
+				std::cout << step << ": " << m.allocations << " allocations, budget " << b.allocations << std::endl;
+				++failures;
+			}
+		}
+
+		std::cout << s.name << ": " << ( failures == 0 ? "ok" : "FAILED" ) << std::endl;
+		return failures;
+	}
+
+	template <typename StyleType>
+	inline std::size_t check_prepared(char const* name)
+	{
+		if( musket::style_memory_usage< StyleType >().size_of_resources > 0 ) {
+			return 0;
+		}
+		std::cout << "prepared_resources: " << name << " drew without device resources" << std::endl;
+		return 1;
+	}
+
+	inline std::size_t verify_prepared_resources()
+	{
+		musket::window wnd = {
+			spirea::rect_t< float >{ { 0, 0 }, { 320, 240 } },
+			"prepared_resources",
+			musket::rgba_color_t{ 0.2f, 0.2f, 0.2f, 0.0f },
+			musket::window_type::offscreen{}
+		};
+
+		musket::widget< musket::button > btn = {
+			spirea::rect_t< float >{ { 60.0f, 150.0f }, { 100.0f, 30.0f } },
+			"Push"
+		};
+		musket::widget< musket::label > lbl = {
+			spirea::rect_t< float >{ { 20.0f, 60.0f }, { 200.0f, 30.0f } },
+			"hello, world!"
+		};
+		musket::widget< musket::scroll_bar< musket::axis_flag::vertical > > scroll = {
+			spirea::rect_t< float >{ { 300.0f, 0.0f }, { 20.0f, 240.0f } },
+			3u, 100u
+		};
+		wnd.attach_widget( btn );
+		wnd.attach_widget( lbl );
+		wnd.attach_widget( scroll );
+		wnd.render_to_bitmap();
+
+		std::size_t failures = 0;
+		failures += check_prepared< musket::button_style >( "button" );
+		failures += check_prepared< musket::label_style >( "label" );
+		failures += check_prepared< musket::scroll_bar_thumb_style >( "scroll_bar" );
+
+		std::cout << "prepared_resources: " << ( failures == 0 ? "ok" : "FAILED" ) << std::endl;
+		return failures;
+	}
+
+	inline int verify(options const& opt)
+	{
+		std::size_t failures = 0;
+		for( auto const& s : example_screens() ) {
+			if( !opt.filter.empty() && s.name.find( opt.filter ) == std::string::npos ) {
+				continue;
+			}
+			failures += verify_screen( s, opt );
+		}
+		if( !opt.update_goldens && ( opt.filter.empty() || std::string{ "prepared_resources" }.find( opt.filter ) != std::string::npos ) ) {
+			failures += verify_prepared_resources();
+		}
+		return failures > 0 ? 1 : 0;
+	}
+
+} // namespace bench
+
+#endif // MUSKET_BENCH_VERIFY_HPP_
\ No newline at end of file
@@ -0,0 +1,61 @@
+//--------------------------------------------------------
+// musket/example/bulk_widgets/bulk_widgets.cpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#include <iostream>
+#include <musket.hpp>
+
+int main()
+{
+	try {
+		musket::window wnd = {
+			spirea::rect_t< float >{ { 0, 0 }, { 1000, 800 } },
+			"bulk widgets"
+		};
+
+		constexpr std::size_t cols = 50;
+		constexpr std::size_t rows = 40;
+
+		std::vector< spirea::rect_t< float > > rects;
+		std::vector< musket::text_request > reqs;
+		for( std::size_t i = 0; i < cols * rows; ++i ) {
+			spirea::rect_t< float > const rc = {
+				{ 20.0f * ( i % cols ), 20.0f * ( i / cols ) },
+				{ 20.0f, 20.0f }
+			};
+			rects.push_back( rc );
+			reqs.push_back( musket::button::request_text( rc, std::to_string( i ) ) );
+		}
+
+		auto texts = musket::prepare_texts( reqs );
+
+		std::vector< musket::widget< musket::button > > buttons;
+		buttons.reserve( texts.size() );
+		for( std::size_t i = 0; i < texts.size(); ++i ) {
+			buttons.emplace_back( rects[i], std::move( texts[i] ) );
+			wnd.attach_widget( buttons.back() );
+		}
+
+		auto const report = musket::style_memory_usage< musket::button_style >();
+		std::cout << "buttons: " << buttons.size()
+			<< ", sizeof(button): " << sizeof( musket::button )
+			<< ", unique styles: " << report.size_of_styles
+			<< ", brush sets: " << report.size_of_resources
+			<< ", shared style memory: " << report.memory_usage << " bytes" << std::endl;
+
+		wnd.show();
+
+		return musket::loop();
+	}
+	catch( std::exception const& e ) {
+		std::cerr << e.what() << std::endl;
+	}
+	catch( ... ) {
+		std::cerr << "unknown error" << std::endl;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+//--------------------------------------------------------
+// musket/example/coroutine/coroutine.cpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#include <iostream>
+#include <numeric>
+#include <musket.hpp>
+
+musket::fire_and_forget run(musket::window wnd, musket::widget< musket::button > btn, musket::widget< musket::label > lbl)
+{
+	for( std::uint64_t n = 1;; ++n ) {
+		co_await musket::next_event( btn, musket::button_event::pressed{} );
+		lbl->set_text( "computing..." );
+		wnd.redraw();
+
+		co_await musket::on_worker();
+		std::vector< std::uint64_t > v( 10000000 );
+		std::iota( v.begin(), v.end(), n );
+		auto const sum = std::accumulate( v.begin(), v.end(), std::uint64_t{ 0 } );
+
+		co_await musket::on_ui( wnd );
+		lbl->set_text( std::to_string( sum ) );
+		wnd.redraw();
+	}
+}
+
+int main()
+{
+	try {
+		musket::window wnd = {
+			spirea::rect_t< float >{ { 0, 0 }, { 320, 240 } },
+			"coroutine"
+		};
+
+		musket::widget< musket::button > btn = {
+			spirea::rect_t< float >{ { 110.0f, 150.0f }, { 100.0f, 30.0f } }, 
+			"Compute" 
+		};
+
+		musket::widget< musket::label > lbl = {
+			spirea::rect_t< float >{ { 60.0f, 60.0f }, { 200.0f, 30.0f } }, 
+			"press the button"
+		};
+
+		wnd.attach_widget( btn );
+		wnd.attach_widget( lbl );
+
+		run( wnd, btn, lbl );
+
+		wnd.show();
+
+		return musket::loop();
+	}
+	catch( std::exception const& e ) {
+		std::cerr << e.what() << std::endl;
+	}
+	catch( ... ) {
+		std::cerr << "unknown error" << std::endl;
+	}
+}
\ No newline at end of file
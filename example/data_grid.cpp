@@ -0,0 +1,55 @@
+//--------------------------------------------------------
+// musket/example/data_grid/data_grid.cpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <musket.hpp>
+
+int main()
+{
+	try {
+		musket::window wnd = {
+			spirea::rect_t< float >{ { 0, 0 }, { 640, 480 } },
+			"data grid",
+		};
+
+		auto const client_rc = wnd.client_area_size();
+
+		musket::data_grid_property prop;
+		prop.header_rows = 1;
+		prop.header_columns = 1;
+
+		musket::widget< musket::auto_scaling_data_grid > grid = {
+			spirea::rect_t< float >{ { 0.0f, 0.0f }, { client_rc.right, client_rc.bottom } },
+			std::size_t{ 1'000'001 }, std::size_t{ 201 },
+			[](std::size_t row, std::size_t col) -> std::string {
+				if( row == 0 ) {
+					return col == 0 ? "" : "col " + std::to_string( col );
+				}
+				if( col == 0 ) {
+					return std::to_string( row );
+				}
+				return std::to_string( row * col );
+			},
+			prop
+		};
+
+		wnd.attach_widget( grid );
+
+		wnd.show();
+
+		return musket::loop();
+	}
+	catch( std::exception const& e ) {
+		std::cerr << e.what() << std::endl;
+	}
+	catch( ... ) {
+		std::cerr << "unknown exception" << std::endl;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+//--------------------------------------------------------
+// musket/example/list_view/list_view.cpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <musket.hpp>
+
+int main()
+{
+	try {
+		musket::window wnd = {
+			spirea::rect_t< float >{ { 0, 0 }, { 320, 240 } },
+			"list view",
+		};
+
+		auto const client_rc = wnd.client_area_size();
+
+		musket::widget< musket::auto_scaling_list_view > list = {
+			spirea::rect_t< float >{ { 0.0f, 0.0f }, { client_rc.right, client_rc.bottom } },
+			std::size_t{ 10'000'000 },
+			[](std::size_t i) { return "row " + std::to_string( i ); }
+		};
+
+		wnd.attach_widget( list );
+
+		wnd.show();
+
+		return musket::loop();
+	}
+	catch( std::exception const& e ) {
+		std::cerr << e.what() << std::endl;
+	}
+	catch( ... ) {
+		std::cerr << "unknown exception" << std::endl;
+	}
+}
\ No newline at end of file
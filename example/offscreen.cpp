@@ -0,0 +1,73 @@
+//--------------------------------------------------------
+// musket/example/offscreen/offscreen.cpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#include <thread>
+#include <atomic>
+#include <iostream>
+#include <musket.hpp>
+
+void render_dashboard(std::size_t index)
+{
+	musket::window wnd = {
+		spirea::rect_t< float >{ { 0, 0 }, { 320, 240 } },
+		"dashboard",
+		musket::rgba_color_t{ 0.2f, 0.2f, 0.2f, 1.0f },
+		musket::window_type::offscreen{ 192.0f }
+	};
+
+	musket::widget< musket::label > title = {
+		spirea::rect_t< float >{ { 20.0f, 20.0f }, { 280.0f, 30.0f } },
+		"dashboard #" + std::to_string( index )
+	};
+	musket::widget< musket::scroll_bar< musket::axis_flag::horizontal > > progress = {
+		spirea::rect_t< float >{ { 20.0f, 80.0f }, { 280.0f, 20.0f } },
+		10u, 100u
+	};
+
+	wnd.attach_widget( title );
+	wnd.attach_widget( progress );
+
+	wnd.render_to_bitmap().save_png( "dashboard_" + std::to_string( index ) + ".png" );
+
+	musket::detach( title );
+	musket::detach( progress );
+}
+
+int main()
+{
+	try {
+		constexpr std::size_t frames = 32;
+		std::atomic< std::size_t > next{ 0 };
+
+		std::vector< std::thread > threads;
+		for( unsigned int i = 0; i < std::max( std::thread::hardware_concurrency(), 1u ); ++i ) {
+			threads.emplace_back( [&next] {
+				try {
+					for( auto n = next++; n < frames; n = next++ ) {
+						render_dashboard( n );
+					}
+				}
+				catch( std::exception const& e ) {
+					std::cerr << e.what() << std::endl;
+				}
+			} );
+		}
+		for( auto& t : threads ) {
+			t.join();
+		}
+
+		std::cout << "rendered " << frames << " dashboards" << std::endl;
+	}
+	catch( std::exception const& e ) {
+		std::cerr << e.what() << std::endl;
+	}
+	catch( ... ) {
+		std::cerr << "unknown error" << std::endl;
+	}
+}
\ No newline at end of file
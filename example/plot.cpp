@@ -0,0 +1,59 @@
+//--------------------------------------------------------
+// musket/example/plot/plot.cpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <musket.hpp>
+
+int main()
+{
+	try {
+		musket::window wnd = {
+			spirea::rect_t< float >{ { 0, 0 }, { 640, 240 } },
+			"plot",
+		};
+
+		auto const client_rc = wnd.client_area_size();
+
+		musket::widget< musket::auto_resizer< musket::plot > > graph = {
+			spirea::rect_t< float >{ { 10.0f, 10.0f }, { client_rc.right - 20.0f, client_rc.bottom - 20.0f } },
+			musket::plot_property{ {}, musket::plot_range{ -1.5f, 1.5f } }
+		};
+
+		std::atomic< bool > running = true;
+		std::thread producer{ [src = graph->source(), &running] {
+			float t = 0.0f;
+			while( running.load( std::memory_order_relaxed ) ) {
+				for( int i = 0; i < 1000; ++i ) {
+					src.push( std::sin( t ) + 0.1f * std::sin( t * 37.0f ) );
+					t += 0.001f;
+				}
+				std::this_thread::sleep_for( std::chrono::milliseconds{ 1 } );
+			}
+		} };
+
+		wnd.attach_widget( graph );
+
+		wnd.show();
+
+		auto const res = musket::event_loop();
+		running = false;
+		producer.join();
+
+		return res;
+	}
+	catch( std::exception const& e ) {
+		std::cerr << e.what() << std::endl;
+	}
+	catch( ... ) {
+		std::cerr << "unknown exception" << std::endl;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+//--------------------------------------------------------
+// musket/example/scroll_view/scroll_view.cpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <musket.hpp>
+
+int main()
+{
+	try {
+		musket::window wnd = {
+			spirea::rect_t< float >{ { 0, 0 }, { 320, 240 } },
+			"scroll view",
+		};
+
+		auto const client_rc = wnd.client_area_size();
+		constexpr float row_height = 30.0f;
+		constexpr std::size_t row_count = 200;
+
+		musket::widget< musket::scroll_view< musket::axis_flag::vertical > > view = {
+			spirea::rect_t< float >{ { 0.0f, 0.0f }, { client_rc.right - 20.0f, client_rc.bottom } },
+			row_height * row_count
+		};
+
+		musket::widget< musket::scroll_bar< musket::axis_flag::vertical > > scroll = {
+			spirea::rect_t< float >{ { client_rc.right - 20.0f, 0.0f }, { 20.0f, client_rc.bottom } },
+			1u, 1u
+		};
+
+		for( std::size_t i = 0; i < row_count; ++i ) {
+			musket::widget< musket::label > lbl = {
+				spirea::rect_t< float >{ { 10.0f, row_height * i }, { client_rc.right - 40.0f, row_height } },
+				"row " + std::to_string( i )
+			};
+			view->attach_widget( lbl );
+		}
+		view->link( scroll );
+
+		wnd.attach_widget( view );
+		wnd.attach_widget( scroll );
+
+		wnd.show();
+
+		return musket::loop();
+	}
+	catch( std::exception const& e ) {
+		std::cerr << e.what() << std::endl;
+	}
+	catch( ... ) {
+		std::cerr << "unknown exception" << std::endl;
+	}
+}
\ No newline at end of file
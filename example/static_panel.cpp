@@ -0,0 +1,52 @@
+//--------------------------------------------------------
+// musket/example/static_panel.cpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#include <iostream>
+#include <musket.hpp>
+
+int main()
+{
+	try {
+		musket::window wnd = {
+			spirea::rect_t< float >{ { 0, 0 }, { 320, 240 } },
+			"static panel"
+		};
+
+		using panel_type = musket::static_panel< musket::button, musket::button, musket::label >;
+
+		musket::widget< panel_type > panel = {
+			spirea::rect_t< float >{ { 0.0f, 0.0f }, { 320.0f, 240.0f } },
+			musket::button{ spirea::rect_t< float >{ { 50.0f, 150.0f }, { 100.0f, 30.0f } }, "Show" },
+			musket::button{ spirea::rect_t< float >{ { 170.0f, 150.0f }, { 100.0f, 30.0f } }, "Hide" },
+			musket::label{ spirea::rect_t< float >{ { 60.0f, 60.0f }, { 200.0f, 30.0f } }, "hello, world!" }
+		};
+
+		auto& lbl = panel->get< 2 >();
+		lbl.hide();
+
+		panel->get< 0 >().connect( musket::button_event::pressed{}, [&lbl](spirea::point_t< std::int32_t > const&) {
+			lbl.show();
+		} );
+		panel->get< 1 >().connect( musket::button_event::pressed{}, [&lbl](spirea::point_t< std::int32_t > const&) {
+			lbl.hide();
+		} );
+
+		wnd.attach_widget( panel );
+
+		wnd.show();
+
+		return musket::loop();
+	}
+	catch( std::exception const& e ) {
+		std::cerr << e.what() << std::endl;
+	}
+	catch( ... ) {
+		std::cerr << "unknown error" << std::endl;
+	}
+}
\ No newline at end of file
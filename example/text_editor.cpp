@@ -0,0 +1,45 @@
+//--------------------------------------------------------
+// musket/example/text_editor/text_editor.cpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#include <iostream>
+#include <musket.hpp>
+
+int main()
+{
+	try {
+		musket::window wnd = {
+			spirea::rect_t< float >{ { 0, 0 }, { 640, 480 } },
+			"text editor",
+		};
+
+		auto const client_rc = wnd.client_area_size();
+
+		std::string text;
+		for( int i = 0; i < 100000; ++i ) {
+			text += "line " + std::to_string( i ) + "\n";
+		}
+
+		musket::widget< musket::auto_scaling_text_editor > editor = {
+			spirea::rect_t< float >{ { 0.0f, 0.0f }, { client_rc.right, client_rc.bottom } },
+			text
+		};
+
+		wnd.attach_widget( editor );
+
+		wnd.show();
+
+		return musket::loop();
+	}
+	catch( std::exception const& e ) {
+		std::cerr << e.what() << std::endl;
+	}
+	catch( ... ) {
+		std::cerr << "unknown exception" << std::endl;
+	}
+}
\ No newline at end of file
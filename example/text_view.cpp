@@ -0,0 +1,45 @@
+//--------------------------------------------------------
+// musket/example/text_view/text_view.cpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#include <iostream>
+#include <musket.hpp>
+
+int main(int argc, char** argv)
+{
+	if( argc < 2 ) {
+		std::cerr << "usage: text_view <file>" << std::endl;
+		return 1;
+	}
+
+	try {
+		musket::window wnd = {
+			spirea::rect_t< float >{ { 0, 0 }, { 640, 480 } },
+			"text view",
+		};
+
+		auto const client_rc = wnd.client_area_size();
+
+		musket::widget< musket::auto_scaling_text_view > view = {
+			spirea::rect_t< float >{ { 0.0f, 0.0f }, { client_rc.right, client_rc.bottom } },
+			argv[1]
+		};
+
+		wnd.attach_widget( view );
+
+		wnd.show();
+
+		return musket::event_loop();
+	}
+	catch( std::exception const& e ) {
+		std::cerr << e.what() << std::endl;
+	}
+	catch( ... ) {
+		std::cerr << "unknown exception" << std::endl;
+	}
+}
\ No newline at end of file
@@ -12,11 +12,21 @@
 
 #include "musket/window.hpp"
 #include "musket/widget.hpp"
+#include "musket/arena.hpp"
 #include "musket/widget/attributes.hpp"
 #include "musket/widget/button.hpp"
 #include "musket/widget/label.hpp"
 #include "musket/widget/scroll_bar.hpp"
+#include "musket/widget/scroll_view.hpp"
+#include "musket/widget/list_view.hpp"
+#include "musket/widget/data_grid.hpp"
+#include "musket/widget/plot.hpp"
+#include "musket/widget/text_view.hpp"
+#include "musket/widget/text_editor.hpp"
+#include "musket/widget/static_panel.hpp"
 #include "musket/detail/window_impl.hpp"
+#include "musket/bitmap.hpp"
+#include "musket/coroutine.hpp"
 #include "musket/utility.hpp"
 
 #endif // MUSKET_HPP_
\ No newline at end of file
@@ -0,0 +1,132 @@
+//--------------------------------------------------------
+// musket/include/musket/arena.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_ARENA_HPP_
+#define MUSKET_ARENA_HPP_
+
+#include <memory>
+#include <utility>
+#include <memory_resource>
+
+namespace musket {
+
+	enum struct arena_kind
+	{
+		monotonic,
+		pooled,
+	};
+
+namespace detail {
+
+	inline std::pmr::memory_resource*& current_arena() noexcept
+	{
+		thread_local std::pmr::memory_resource* mr = nullptr;
+		return mr;
+	}
+
+} // namespace detail
+
+	class widget_arena
+	{
+		std::unique_ptr< std::pmr::memory_resource > resource_;
+
+	public:
+		explicit widget_arena(
+			arena_kind kind = arena_kind::monotonic,
+			std::size_t initial_size = 64 * 1024,
+			std::pmr::memory_resource* upstream = std::pmr::get_default_resource()
+		)
+		{
+			if( kind == arena_kind::monotonic ) {
+				resource_ = std::make_unique< std::pmr::monotonic_buffer_resource >( initial_size, upstream );
+			}
+			else {
+				resource_ = std::make_unique< std::pmr::unsynchronized_pool_resource >( upstream );
+			}
+		}
+
+		widget_arena(widget_arena const&) = delete;
+		widget_arena& operator=(widget_arena const&) = delete;
+
+		std::pmr::memory_resource* resource() const noexcept
+		{
+			return resource_.get();
+		}
+
+		operator std::pmr::memory_resource*() const noexcept
+		{
+			return resource_.get();
+		}
+	};
+
+	class arena_scope
+	{
+		std::pmr::memory_resource* prev_;
+
+	public:
+		explicit arena_scope(widget_arena const& arena) noexcept :
+			prev_{ std::exchange( detail::current_arena(), arena.resource() ) }
+		{ }
+
+		~arena_scope() noexcept
+		{
+			detail::current_arena() = prev_;
+		}
+
+		arena_scope(arena_scope const&) = delete;
+		arena_scope& operator=(arena_scope const&) = delete;
+	};
+
+namespace detail {
+
+	template <typename T, typename... Args>
+	inline T* arena_new(std::pmr::memory_resource* mr, Args&&... args)
+	{
+		if( !mr ) {
+			return new T{ std::forward< Args >( args )... };
+		}
+
+		auto const p = mr->allocate( sizeof( T ), alignof( T ) );
+		try {
+			return ::new( p ) T{ std::forward< Args >( args )... };
+		}
+		catch( ... ) {
+			mr->deallocate( p, sizeof( T ), alignof( T ) );
+			throw;
+		}
+	}
+
+	template <typename T>
+	inline void arena_delete(std::pmr::memory_resource* mr, T* p) noexcept
+	{
+		if( !mr ) {
+			delete p;
+			return;
+		}
+
+		p->~T();
+		mr->deallocate( p, sizeof( T ), alignof( T ) );
+	}
+
+	template <typename T>
+	struct arena_deleter
+	{
+		std::pmr::memory_resource* mr = nullptr;
+
+		void operator()(T* p) const noexcept
+		{
+			arena_delete( mr, p );
+		}
+	};
+
+} // namespace detail
+
+} // namespace musket
+
+#endif // MUSKET_ARENA_HPP_
\ No newline at end of file
@@ -0,0 +1,130 @@
+//--------------------------------------------------------
+// musket/include/musket/bitmap.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_BITMAP_HPP_
+#define MUSKET_BITMAP_HPP_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <string_view>
+#include "detail/wic.hpp"
+
+namespace musket {
+
+	struct bitmap_view
+	{
+		std::uint8_t* data;
+		std::uint32_t width;
+		std::uint32_t height;
+		std::uint32_t stride;
+	};
+
+	class bitmap
+	{
+		std::uint32_t width_ = 0;
+		std::uint32_t height_ = 0;
+		std::vector< std::uint32_t > pixels_;
+
+	public:
+		bitmap() = default;
+
+		bitmap(std::uint32_t width, std::uint32_t height) :
+			width_{ width },
+			height_{ height },
+			pixels_( static_cast< std::size_t >( width ) * height )
+		{ }
+
+		std::uint32_t width() const noexcept
+		{
+			return width_;
+		}
+
+		std::uint32_t height() const noexcept
+		{
+			return height_;
+		}
+
+		std::uint32_t stride() const noexcept
+		{
+			return width_ * 4;
+		}
+
+		std::vector< std::uint32_t > const& pixels() const noexcept
+		{
+			return pixels_;
+		}
+
+		std::uint32_t pixel(std::uint32_t x, std::uint32_t y) const noexcept
+		{
+			return pixels_[static_cast< std::size_t >( y ) * width_ + x];
+		}
+
+		bitmap_view view() noexcept
+		{
+			return { reinterpret_cast< std::uint8_t* >( pixels_.data() ), width_, height_, stride() };
+		}
+
+		std::vector< std::uint8_t > encode_png() const
+		{
+			auto const factory = detail::wic_factory();
+
+			detail::com_ptr< IWICBitmap > src;
+			spirea::windows::try_hresult( factory->CreateBitmapFromMemory(
+				width_, height_, GUID_WICPixelFormat32bppPBGRA, stride(),
+				static_cast< UINT >( pixels_.size() * sizeof( std::uint32_t ) ),
+				reinterpret_cast< BYTE* >( const_cast< std::uint32_t* >( pixels_.data() ) ),
+				src.pp()
+			) );
+
+			detail::com_ptr< IStream > stream;
+			spirea::windows::try_hresult( CreateStreamOnHGlobal( nullptr, TRUE, stream.pp() ) );
+
+			detail::com_ptr< IWICBitmapEncoder > encoder;
+			spirea::windows::try_hresult( factory->CreateEncoder( GUID_ContainerFormatPng, nullptr, encoder.pp() ) );
+			spirea::windows::try_hresult( encoder->Initialize( stream.get(), WICBitmapEncoderNoCache ) );
+
+			detail::com_ptr< IWICBitmapFrameEncode > frame;
+			spirea::windows::try_hresult( encoder->CreateNewFrame( frame.pp(), nullptr ) );
+			spirea::windows::try_hresult( frame->Initialize( nullptr ) );
+			spirea::windows::try_hresult( frame->SetSize( width_, height_ ) );
+			WICPixelFormatGUID format = GUID_WICPixelFormat32bppBGRA;
+			spirea::windows::try_hresult( frame->SetPixelFormat( &format ) );
+			spirea::windows::try_hresult( frame->WriteSource( src.get(), nullptr ) );
+			spirea::windows::try_hresult( frame->Commit() );
+			spirea::windows::try_hresult( encoder->Commit() );
+
+			STATSTG stat;
+			spirea::windows::try_hresult( stream->Stat( &stat, STATFLAG_NONAME ) );
+			LARGE_INTEGER const origin = {};
+			spirea::windows::try_hresult( stream->Seek( origin, STREAM_SEEK_SET, nullptr ) );
+
+			std::vector< std::uint8_t > png( static_cast< std::size_t >( stat.cbSize.QuadPart ) );
+			ULONG read = 0;
+			spirea::windows::try_hresult( stream->Read( png.data(), static_cast< ULONG >( png.size() ), &read ) );
+			png.resize( read );
+			return png;
+		}
+
+		bool save_png(std::string_view path) const
+		{
+			std::ofstream ofs{ std::string{ path.begin(), path.end() }, std::ios::binary };
+			if( !ofs ) {
+				return false;
+			}
+			auto const png = encode_png();
+			ofs.write( reinterpret_cast< char const* >( png.data() ), static_cast< std::streamsize >( png.size() ) );
+			return static_cast< bool >( ofs );
+		}
+	};
+
+} // namespace musket
+
+#endif // MUSKET_BITMAP_HPP_
\ No newline at end of file
@@ -10,16 +10,124 @@
 #ifndef MUSKET_COLOR_HPP_
 #define MUSKET_COLOR_HPP_
 
+#include <array>
+#include <cmath>
+#include <limits>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
 #include <spirea/mp/container.hpp>
 #include <spirea/windows/d2d1.hpp>
 
+#if defined( _M_X64 ) || defined( __SSE2__ )
+#include <emmintrin.h>
+#define MUSKET_HAS_SSE2
+#endif
+
 namespace musket {
 
 	template <typename T>
 	struct rgba_color_traits_impl;
 
+	class rgba8
+	{
+		static constexpr std::uint8_t unorm(float v) noexcept
+		{
+			return static_cast< std::uint8_t >( std::clamp( v, 0.0f, 1.0f ) * 255.0f + 0.5f );
+		}
+
+	public:
+		using value_type = std::uint8_t;
+
+		std::uint8_t r = 0;
+		std::uint8_t g = 0;
+		std::uint8_t b = 0;
+		std::uint8_t a = 0;
+
+		constexpr rgba8() noexcept = default;
+
+		constexpr rgba8(float red, float green, float blue, float alpha = 1.0f) noexcept :
+			r{ unorm( red ) },
+			g{ unorm( green ) },
+			b{ unorm( blue ) },
+			a{ unorm( alpha ) }
+		{ }
+
+		constexpr rgba8(spirea::d2d1::color_f const& c) noexcept :
+			rgba8{ c.r, c.g, c.b, c.a }
+		{ }
+
+		static constexpr rgba8 from_bytes(std::uint8_t red, std::uint8_t green, std::uint8_t blue, std::uint8_t alpha = 255) noexcept
+		{
+			rgba8 c;
+			c.r = red;
+			c.g = green;
+			c.b = blue;
+			c.a = alpha;
+			return c;
+		}
+	};
+
 namespace rgba_color_traits_detail {
 
+	constexpr std::array< float, 256 > make_unorm8_table() noexcept
+	{
+		std::array< float, 256 > table = {};
+		for( std::size_t i = 0; i < table.size(); ++i ) {
+			table[i] = static_cast< float >( i ) / 255.0f;
+		}
+		return table;
+	}
+
+	inline std::array< float, 256 > make_srgb_to_linear_table() noexcept
+	{
+		std::array< float, 256 > table = {};
+		for( std::size_t i = 0; i < table.size(); ++i ) {
+			auto const c = static_cast< float >( i ) / 255.0f;
+			table[i] = c <= 0.04045f ? c / 12.92f : std::pow( ( c + 0.055f ) / 1.055f, 2.4f );
+		}
+		return table;
+	}
+
+	inline constexpr std::array< float, 256 > unorm8_table = make_unorm8_table();
+	inline std::array< float, 256 > const srgb_to_linear_table = make_srgb_to_linear_table();
+
+	template <typename To, typename From>
+	constexpr To convert_channel(From v) noexcept
+	{
+		if constexpr( std::is_integral_v< From > == std::is_integral_v< To > ) {
+			return static_cast< To >( v );
+		}
+		else if constexpr( std::is_same_v< From, std::uint8_t > ) {
+			return static_cast< To >( unorm8_table[v] );
+		}
+		else if constexpr( std::is_integral_v< From > ) {
+			return static_cast< To >( v ) / static_cast< To >( std::numeric_limits< From >::max() );
+		}
+		else {
+			return static_cast< To >( std::clamp( v, From( 0 ), From( 1 ) ) * std::numeric_limits< To >::max() + From( 0.5 ) );
+		}
+	}
+
+	inline spirea::d2d1::color_f unpack(rgba8 const& c) noexcept
+	{
+#ifdef MUSKET_HAS_SSE2
+		std::uint32_t bits;
+		std::memcpy( &bits, &c, sizeof( bits ) );
+
+		auto const zero = _mm_setzero_si128();
+		auto v = _mm_cvtsi32_si128( static_cast< int >( bits ) );
+		v = _mm_unpacklo_epi8( v, zero );
+		v = _mm_unpacklo_epi16( v, zero );
+
+		spirea::d2d1::color_f res;
+		_mm_storeu_ps( &res.r, _mm_mul_ps( _mm_cvtepi32_ps( v ), _mm_set1_ps( 1.0f / 255.0f ) ) );
+		return res;
+#else
+		return { unorm8_table[c.r], unorm8_table[c.g], unorm8_table[c.b], unorm8_table[c.a] };
+#endif
+	}
+
 	template <typename T, typename = void>
 	struct has_construct_function :
 		std::false_type
@@ -98,12 +206,18 @@ namespace rgba_color_traits_detail {
 		template <typename U>
 		static type construct(U const& c) noexcept
 		{
-			return construct( 
-				static_cast< value_type >( rgba_color_traits< U >::red( c ) ),
-				static_cast< value_type >( rgba_color_traits< U >::green( c ) ),
-				static_cast< value_type >( rgba_color_traits< U >::blue( c ) ),
-				static_cast< value_type >( rgba_color_traits< U >::alpha( c ) )
-			);
+			if constexpr( std::is_same_v< U, rgba8 > && std::is_same_v< type, spirea::d2d1::color_f > ) {
+				return rgba_color_traits_detail::unpack( c );
+			}
+			else {
+				using src_type = typename rgba_color_traits< U >::value_type;
+				return construct( 
+					rgba_color_traits_detail::convert_channel< value_type, src_type >( rgba_color_traits< U >::red( c ) ),
+					rgba_color_traits_detail::convert_channel< value_type, src_type >( rgba_color_traits< U >::green( c ) ),
+					rgba_color_traits_detail::convert_channel< value_type, src_type >( rgba_color_traits< U >::blue( c ) ),
+					rgba_color_traits_detail::convert_channel< value_type, src_type >( rgba_color_traits< U >::alpha( c ) )
+				);
+			}
 		}
 
 		static value_type& red(type& c) noexcept
@@ -193,8 +307,45 @@ namespace rgba_color_traits_detail {
 		using value_type = float;
 	};
 
+	template <>
+	struct rgba_color_traits_impl< rgba8 >
+	{
+		using value_type = std::uint8_t;
+
+		static rgba8 construct(value_type r, value_type g, value_type b, value_type a) noexcept
+		{
+			return rgba8::from_bytes( r, g, b, a );
+		}
+	};
+
 	using rgba_color_t = spirea::d2d1::color_f;
 
+	inline rgba_color_t to_linear(rgba8 const& c) noexcept
+	{
+		auto const& table = rgba_color_traits_detail::srgb_to_linear_table;
+		return { table[c.r], table[c.g], table[c.b], rgba_color_traits_detail::unorm8_table[c.a] };
+	}
+
+	template <typename Color>
+	inline Color lerp_color(Color const& a, Color const& b, float t) noexcept
+	{
+		using traits = rgba_color_traits< Color >;
+		using value_type = typename traits::value_type;
+
+		auto const f = [t](value_type x, value_type y) {
+			auto const fx = rgba_color_traits_detail::convert_channel< float >( x );
+			auto const fy = rgba_color_traits_detail::convert_channel< float >( y );
+			return rgba_color_traits_detail::convert_channel< value_type >( fx + ( fy - fx ) * t );
+		};
+
+		return traits::construct(
+			f( traits::red( a ), traits::red( b ) ),
+			f( traits::green( a ), traits::green( b ) ),
+			f( traits::blue( a ), traits::blue( b ) ),
+			f( traits::alpha( a ), traits::alpha( b ) )
+		);
+	}
+
 } // namespace musket
 
 #endif // MUSKET_COLOR_HPP_
\ No newline at end of file
@@ -0,0 +1,203 @@
+//--------------------------------------------------------
+// musket/include/musket/coroutine.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_COROUTINE_HPP_
+#define MUSKET_COROUTINE_HPP_
+
+#if defined( __cpp_impl_coroutine ) && __has_include( <coroutine> )
+#include <coroutine>
+#define MUSKET_HAS_COROUTINE
+#elif defined( __cpp_coroutines ) && __has_include( <experimental/coroutine> )
+#include <experimental/coroutine>
+#define MUSKET_HAS_COROUTINE
+#define MUSKET_EXPERIMENTAL_COROUTINE
+#endif
+
+#ifdef MUSKET_HAS_COROUTINE
+
+#include <tuple>
+#include <thread>
+#include <optional>
+#include <exception>
+#include <type_traits>
+#include "window.hpp"
+#include "detail/thread_pool.hpp"
+
+namespace musket {
+
+namespace detail {
+
+#ifdef MUSKET_EXPERIMENTAL_COROUTINE
+	namespace coro = std::experimental;
+#else
+	namespace coro = std;
+#endif
+
+	template <typename Connector, typename Signature>
+	class event_awaiter;
+
+	template <typename Connector, typename R, typename... Args>
+	class event_awaiter< Connector, R (Args...) >
+	{
+		Connector connect_;
+		spirea::connection conn_;
+		std::optional< std::tuple< std::decay_t< Args >... > > args_;
+
+	public:
+		explicit event_awaiter(Connector connect) :
+			connect_{ std::move( connect ) }
+		{ }
+
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		void await_suspend(coro::coroutine_handle<> h)
+		{
+			conn_ = connect_( [this, h](Args... args) {
+				auto const self = this;
+				auto const handle = h;
+				self->args_.emplace( args... );
+				self->conn_.disconnect();
+				handle.resume();
+			} );
+		}
+
+		auto await_resume()
+		{
+			if constexpr( sizeof...( Args ) == 1 ) {
+				return std::get< 0 >( std::move( *args_ ) );
+			}
+			else if constexpr( sizeof...( Args ) > 1 ) {
+				return std::move( *args_ );
+			}
+		}
+	};
+
+	template <typename Signature, typename Connector>
+	inline event_awaiter< Connector, Signature > make_event_awaiter(Connector&& connect)
+	{
+		return event_awaiter< Connector, Signature >{ std::forward< Connector >( connect ) };
+	}
+
+	class worker_awaiter
+	{
+		thread_pool& pool_;
+
+	public:
+		explicit worker_awaiter(thread_pool& pool) noexcept :
+			pool_{ pool }
+		{ }
+
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		void await_suspend(coro::coroutine_handle<> h)
+		{
+			pool_.submit( [h] { h.resume(); } );
+		}
+
+		void await_resume() const noexcept
+		{ }
+	};
+
+	class ui_awaiter
+	{
+		window wnd_;
+
+	public:
+		explicit ui_awaiter(window const& wnd) :
+			wnd_{ wnd }
+		{ }
+
+		bool await_ready() const noexcept
+		{
+			return GetWindowThreadProcessId( wnd_.window_handle().handle(), nullptr ) == GetCurrentThreadId();
+		}
+
+		void await_suspend(coro::coroutine_handle<> h)
+		{
+			while( !wnd_.post( [h](window&) { h.resume(); } ) ) {
+				if( !IsWindow( wnd_.window_handle().handle() ) ) {
+					h.destroy();
+					return;
+				}
+				std::this_thread::yield();
+			}
+		}
+
+		void await_resume() const noexcept
+		{ }
+	};
+
+} // namespace detail
+
+	struct fire_and_forget
+	{
+		struct promise_type
+		{
+			fire_and_forget get_return_object() const noexcept
+			{
+				return {};
+			}
+
+			detail::coro::suspend_never initial_suspend() const noexcept
+			{
+				return {};
+			}
+
+			detail::coro::suspend_never final_suspend() const noexcept
+			{
+				return {};
+			}
+
+			void return_void() const noexcept
+			{ }
+
+			void unhandled_exception() const noexcept
+			{
+				std::terminate();
+			}
+		};
+	};
+
+	inline detail::worker_awaiter on_worker(detail::thread_pool& pool = detail::default_thread_pool())
+	{
+		return detail::worker_awaiter{ pool };
+	}
+
+	inline detail::ui_awaiter on_ui(window const& wnd)
+	{
+		return detail::ui_awaiter{ wnd };
+	}
+
+	template <typename T, typename Event>
+	inline auto next_event(widget< T >& w, Event)
+	{
+		return detail::make_event_awaiter< typename Event::template type< T > >( [w](auto&& f) mutable {
+			return w->connect( Event{}, std::forward< decltype( f ) >( f ) );
+		} );
+	}
+
+	template <typename Event>
+	inline auto next_event(window& wnd, Event)
+	{
+		return detail::make_event_awaiter< typename Event::template type< window > >( [wnd](auto&& f) mutable {
+			return wnd.connect( Event{}, std::forward< decltype( f ) >( f ) );
+		} );
+	}
+
+} // namespace musket
+
+#endif // MUSKET_HAS_COROUTINE
+
+#endif // MUSKET_COROUTINE_HPP_
\ No newline at end of file
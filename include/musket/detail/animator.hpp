@@ -0,0 +1,241 @@
+//--------------------------------------------------------
+// musket/include/musket/detail/animator.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_DETAIL_ANIMATOR_HPP_
+#define MUSKET_DETAIL_ANIMATOR_HPP_
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "../geometry.hpp"
+
+namespace musket {
+
+	enum struct easing : std::uint8_t
+	{
+		linear,
+		ease_in,
+		ease_out,
+		ease_in_out,
+	};
+
+namespace detail {
+
+	inline float apply_easing(easing e, float t) noexcept
+	{
+		switch( e ) {
+		case easing::linear:
+			return t;
+		case easing::ease_in:
+			return t * t * t;
+		case easing::ease_out:
+			return 1.0f - ( 1.0f - t ) * ( 1.0f - t ) * ( 1.0f - t );
+		case easing::ease_in_out:
+			return t * t * ( 3.0f - 2.0f * t );
+		}
+		return t;
+	}
+
+	class animator
+	{
+		std::vector< float > from_;
+		std::vector< float > to_;
+		std::vector< float > value_;
+		std::vector< float > start_;
+		std::vector< float > duration_;
+		std::vector< easing > easing_;
+		std::vector< std::uint8_t > running_;
+		std::vector< spirea::rect_t< float > > bounds_;
+		std::vector< std::uint32_t > generation_;
+		std::vector< std::uint32_t > free_;
+		std::size_t running_count_ = 0;
+
+	public:
+		std::size_t size_of_running() const noexcept
+		{
+			return running_count_;
+		}
+
+		std::uint32_t start(float from, float to, float now, float duration, spirea::rect_t< float > const& bounds, easing e)
+		{
+			std::uint32_t i;
+			if( free_.empty() ) {
+				i = static_cast< std::uint32_t >( value_.size() );
+				from_.push_back( 0.0f );
+				to_.push_back( 0.0f );
+				value_.push_back( 0.0f );
+				start_.push_back( 0.0f );
+				duration_.push_back( 0.0f );
+				easing_.push_back( easing::linear );
+				running_.push_back( 0 );
+				bounds_.push_back( {} );
+				generation_.push_back( 0 );
+			}
+			else {
+				i = free_.back();
+				free_.pop_back();
+			}
+
+			from_[i] = from;
+			to_[i] = to;
+			value_[i] = from;
+			start_[i] = now;
+			duration_[i] = std::max( duration, 1.0f );
+			easing_[i] = e;
+			bounds_[i] = bounds;
+			running_[i] = 1;
+			++running_count_;
+
+			return i;
+		}
+
+		std::uint32_t generation(std::uint32_t i) const noexcept
+		{
+			return generation_[i];
+		}
+
+		bool is_valid(std::uint32_t i, std::uint32_t gen) const noexcept
+		{
+			return i < generation_.size() && generation_[i] == gen;
+		}
+
+		bool is_running(std::uint32_t i, std::uint32_t gen) const noexcept
+		{
+			return is_valid( i, gen ) && running_[i];
+		}
+
+		float value(std::uint32_t i, std::uint32_t gen) const noexcept
+		{
+			return is_valid( i, gen ) ? value_[i] : 0.0f;
+		}
+
+		void set_bounds(std::uint32_t i, std::uint32_t gen, spirea::rect_t< float > const& bounds) noexcept
+		{
+			if( is_valid( i, gen ) ) {
+				bounds_[i] = bounds;
+			}
+		}
+
+		void release(std::uint32_t i, std::uint32_t gen)
+		{
+			if( !is_valid( i, gen ) ) {
+				return;
+			}
+			if( running_[i] ) {
+				running_[i] = 0;
+				--running_count_;
+			}
+			++generation_[i];
+			free_.push_back( i );
+		}
+
+		template <typename F>
+		bool advance(float now, F&& invalidate)
+		{
+			if( running_count_ == 0 ) {
+				return false;
+			}
+
+			auto const n = value_.size();
+			for( std::size_t i = 0; i < n; ++i ) {
+				if( !running_[i] ) {
+					continue;
+				}
+
+				auto const t = std::clamp( ( now - start_[i] ) / duration_[i], 0.0f, 1.0f );
+				value_[i] = from_[i] + ( to_[i] - from_[i] ) * apply_easing( easing_[i], t );
+				if( t >= 1.0f ) {
+					running_[i] = 0;
+					--running_count_;
+				}
+				invalidate( bounds_[i] );
+			}
+
+			return running_count_ > 0;
+		}
+	};
+
+} // namespace detail
+
+	class animation
+	{
+		std::weak_ptr< detail::animator > anim_;
+		std::uint32_t index_ = 0;
+		std::uint32_t generation_ = 0;
+
+	public:
+		animation() = default;
+
+		animation(std::weak_ptr< detail::animator > const& anim, std::uint32_t index) :
+			anim_{ anim },
+			index_{ index },
+			generation_{ anim.lock()->generation( index ) }
+		{ }
+
+		animation(animation const&) = delete;
+		animation& operator=(animation const&) = delete;
+
+		animation(animation&& other) noexcept :
+			anim_{ std::move( other.anim_ ) },
+			index_{ other.index_ },
+			generation_{ other.generation_ }
+		{
+			other.anim_.reset();
+		}
+
+		animation& operator=(animation&& other) noexcept
+		{
+			if( this != &other ) {
+				reset();
+				anim_ = std::move( other.anim_ );
+				index_ = other.index_;
+				generation_ = other.generation_;
+				other.anim_.reset();
+			}
+			return *this;
+		}
+
+		~animation() noexcept
+		{
+			reset();
+		}
+
+		bool is_running() const noexcept
+		{
+			auto const p = anim_.lock();
+			return p && p->is_running( index_, generation_ );
+		}
+
+		float value(float otherwise = 1.0f) const noexcept
+		{
+			auto const p = anim_.lock();
+			return p && p->is_valid( index_, generation_ ) ? p->value( index_, generation_ ) : otherwise;
+		}
+
+		template <typename Rect>
+		void set_bounds(Rect const& rc) noexcept
+		{
+			if( auto const p = anim_.lock() ) {
+				p->set_bounds( index_, generation_, spirea::rect_traits< spirea::rect_t< float > >::construct( rc ) );
+			}
+		}
+
+		void reset() noexcept
+		{
+			if( auto const p = anim_.lock() ) {
+				p->release( index_, generation_ );
+			}
+			anim_.reset();
+		}
+	};
+
+} // namespace musket
+
+#endif // MUSKET_DETAIL_ANIMATOR_HPP_
\ No newline at end of file
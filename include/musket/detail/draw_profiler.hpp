@@ -0,0 +1,254 @@
+//--------------------------------------------------------
+// musket/include/musket/detail/draw_profiler.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_DETAIL_DRAW_PROFILER_HPP_
+#define MUSKET_DETAIL_DRAW_PROFILER_HPP_
+
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include <unordered_map>
+#include <spirea/windows/d2d1.hpp>
+#include "../geometry.hpp"
+
+namespace musket {
+
+	struct widget_cost
+	{
+		char const* type = nullptr;
+		void const* instance = nullptr;
+		spirea::rect_t< float > bounds = {};
+		std::uint64_t draws = 0;
+		std::uint64_t events = 0;
+		double draw_us = 0.0;
+		double handler_us = 0.0;
+		double recent_draw_us = 0.0;
+	};
+
+	struct widget_type_cost
+	{
+		char const* type = nullptr;
+		std::size_t instances = 0;
+		std::uint64_t draws = 0;
+		std::uint64_t events = 0;
+		double draw_us = 0.0;
+		double handler_us = 0.0;
+	};
+
+namespace detail {
+
+	template <typename T, typename = void>
+	struct has_widget_size :
+		std::false_type
+	{ };
+
+	template <typename T>
+	struct has_widget_size< T, std::void_t< decltype( std::declval< T const& >().size() ) > > :
+		std::true_type
+	{ };
+
+	class draw_profiler
+	{
+		using clock = std::chrono::steady_clock;
+
+		struct tracked
+		{
+			std::weak_ptr< void const > alive;
+			widget_cost cost;
+		};
+
+		std::unordered_map< void const*, tracked > costs_;
+		std::size_t prune_at_ = 64;
+		bool enabled_ = false;
+		bool overlay_ = false;
+		spirea::d2d1::solid_color_brush brush_;
+		std::uint64_t brush_generation_ = 0;
+
+	public:
+		class scope
+		{
+			widget_cost& cost_;
+			bool draw_;
+			clock::time_point start_ = clock::now();
+
+		public:
+			scope(widget_cost& cost, bool draw) noexcept :
+				cost_{ cost },
+				draw_{ draw }
+			{ }
+
+			~scope() noexcept
+			{
+				auto const us = std::chrono::duration< double, std::micro >( clock::now() - start_ ).count();
+				if( draw_ ) {
+					++cost_.draws;
+					cost_.draw_us += us;
+					cost_.recent_draw_us = cost_.draws == 1 ? us : cost_.recent_draw_us * 0.8 + us * 0.2;
+				}
+				else {
+					++cost_.events;
+					cost_.handler_us += us;
+				}
+			}
+
+			scope(scope const&) = delete;
+			scope& operator=(scope const&) = delete;
+		};
+
+		bool is_enabled() const noexcept
+		{
+			return enabled_;
+		}
+
+		void enable(bool enabled) noexcept
+		{
+			enabled_ = enabled;
+		}
+
+		bool is_overlay_visible() const noexcept
+		{
+			return overlay_;
+		}
+
+		void show_overlay(bool visible) noexcept
+		{
+			overlay_ = visible;
+			enabled_ = enabled_ || visible;
+		}
+
+		void clear() noexcept
+		{
+			costs_.clear();
+		}
+
+		widget_cost& entry(void const* instance, std::weak_ptr< void const > alive, char const* type, spirea::rect_t< float > const& bounds)
+		{
+			if( costs_.size() >= prune_at_ ) {
+				prune();
+				prune_at_ = std::max< std::size_t >( costs_.size() * 2, 64 );
+			}
+
+			auto& t = costs_[instance];
+			if( t.alive.owner_before( alive ) || alive.owner_before( t.alive ) ) {
+				t = { std::move( alive ), {} };
+			}
+
+			auto& c = t.cost;
+			c.type = type;
+			c.instance = instance;
+			c.bounds = bounds;
+			return c;
+		}
+
+		void forget(void const* instance) noexcept
+		{
+			costs_.erase( instance );
+		}
+
+		std::vector< widget_cost > top(std::size_t n) const
+		{
+			std::vector< widget_cost > v;
+			v.reserve( costs_.size() );
+			for( auto const& i : costs_ ) {
+				if( !i.second.alive.expired() ) {
+					v.push_back( i.second.cost );
+				}
+			}
+
+			n = std::min( n, v.size() );
+			std::partial_sort( v.begin(), v.begin() + n, v.end(), [](auto const& a, auto const& b) {
+				return a.draw_us + a.handler_us > b.draw_us + b.handler_us;
+			} );
+			v.resize( n );
+			return v;
+		}
+
+		std::vector< widget_type_cost > by_type() const
+		{
+			std::unordered_map< char const*, widget_type_cost > types;
+			for( auto const& i : costs_ ) {
+				if( i.second.alive.expired() ) {
+					continue;
+				}
+
+				auto const& c = i.second.cost;
+				auto& t = types[c.type];
+				t.type = c.type;
+				++t.instances;
+				t.draws += c.draws;
+				t.events += c.events;
+				t.draw_us += c.draw_us;
+				t.handler_us += c.handler_us;
+			}
+
+			std::vector< widget_type_cost > v;
+			v.reserve( types.size() );
+			for( auto const& i : types ) {
+				v.push_back( i.second );
+			}
+			std::sort( v.begin(), v.end(), [](auto const& a, auto const& b) {
+				return a.draw_us + a.handler_us > b.draw_us + b.handler_us;
+			} );
+			return v;
+		}
+
+		void draw_overlay(spirea::d2d1::render_target const& rt, std::uint64_t generation)
+		{
+			if( !overlay_ ) {
+				return;
+			}
+
+			prune();
+			if( costs_.empty() ) {
+				return;
+			}
+
+			if( !brush_ || brush_generation_ != generation ) {
+				brush_.reset();
+				spirea::windows::try_hresult( rt->CreateSolidColorBrush( spirea::d2d1::color_f{ 0.0f, 0.0f, 0.0f, 0.0f }, brush_.pp() ) );
+				brush_generation_ = generation;
+			}
+
+			double peak = 0.0;
+			for( auto const& i : costs_ ) {
+				peak = std::max( peak, i.second.cost.recent_draw_us );
+			}
+			if( peak <= 0.0 ) {
+				return;
+			}
+
+			for( auto const& i : costs_ ) {
+				auto const t = static_cast< float >( i.second.cost.recent_draw_us / peak );
+				brush_->SetColor( spirea::d2d1::color_f{ t, 1.0f - t, 0.0f, 0.15f + 0.35f * t } );
+				rt->FillRectangle( spirea::rect_traits< spirea::d2d1::rect_f >::construct( i.second.cost.bounds ), brush_.get() );
+			}
+		}
+
+	private:
+		void prune()
+		{
+			for( auto itr = costs_.begin(); itr != costs_.end(); ) {
+				if( itr->second.alive.expired() ) {
+					itr = costs_.erase( itr );
+				}
+				else {
+					++itr;
+				}
+			}
+		}
+	};
+
+} // namespace detail
+
+} // namespace musket
+
+#endif // MUSKET_DETAIL_DRAW_PROFILER_HPP_
\ No newline at end of file
@@ -0,0 +1,204 @@
+//--------------------------------------------------------
+// musket/include/musket/detail/line_index.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_DETAIL_LINE_INDEX_HPP_
+#define MUSKET_DETAIL_LINE_INDEX_HPP_
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <exception>
+#include <algorithm>
+#include <string_view>
+#include <optional>
+#include <functional>
+#include "mapped_file.hpp"
+
+namespace musket {
+
+namespace detail {
+
+	class line_index
+	{
+		static constexpr std::uint64_t stride = 64;
+		static constexpr std::size_t view_size = 64 << 20;
+		static constexpr std::size_t publish_size = 4 << 20;
+
+		std::shared_ptr< file_mapping const > file_;
+		std::function< void () > on_progress_;
+		mutable std::mutex mtx_;
+		std::vector< std::uint64_t > checkpoints_;
+		std::exception_ptr error_;
+		std::atomic< std::uint64_t > lines_{ 0 };
+		std::atomic< bool > complete_{ false };
+		std::atomic< bool > stop_{ false };
+		std::thread thread_;
+
+	public:
+		explicit line_index(std::shared_ptr< file_mapping const > const& file, std::function< void () > on_progress = {}) :
+			file_{ file },
+			on_progress_{ std::move( on_progress ) }
+		{
+			thread_ = std::thread{ [this] { run(); } };
+		}
+
+		line_index(line_index const&) = delete;
+		line_index& operator=(line_index const&) = delete;
+
+		~line_index() noexcept
+		{
+			stop_.store( true, std::memory_order_relaxed );
+			if( thread_.joinable() ) {
+				thread_.join();
+			}
+		}
+
+		std::uint64_t size() const noexcept
+		{
+			return lines_.load( std::memory_order_acquire );
+		}
+
+		bool is_complete() const noexcept
+		{
+			return complete_.load( std::memory_order_acquire );
+		}
+
+		std::exception_ptr error() const
+		{
+			std::lock_guard lock{ mtx_ };
+			return error_;
+		}
+
+		std::size_t memory_usage() const noexcept
+		{
+			std::lock_guard lock{ mtx_ };
+			return checkpoints_.capacity() * sizeof( std::uint64_t );
+		}
+
+		std::optional< std::string_view > line(std::uint64_t n, char const* data, std::size_t max_length) const
+		{
+			if( n >= size() ) {
+				return std::nullopt;
+			}
+
+			std::uint64_t offset;
+			{
+				std::lock_guard lock{ mtx_ };
+				offset = checkpoints_[static_cast< std::size_t >( n / stride )];
+			}
+
+			auto const file_size = file_->size();
+			for( auto k = n % stride; k > 0; --k ) {
+				auto const p = static_cast< char const* >( std::memchr( data + offset, '\n', static_cast< std::size_t >( file_size - offset ) ) );
+				if( !p ) {
+					return std::nullopt;
+				}
+				offset = static_cast< std::uint64_t >( p - data ) + 1;
+			}
+			if( offset > file_size ) {
+				return std::nullopt;
+			}
+
+			auto const rest = static_cast< std::size_t >( file_size - offset );
+			auto const p = static_cast< char const* >( std::memchr( data + offset, '\n', rest ) );
+			auto len = p ? static_cast< std::size_t >( p - ( data + offset ) ) : rest;
+			if( len > 0 && data[offset + len - 1] == '\r' ) {
+				--len;
+			}
+
+			return std::string_view{ data + offset, std::min( len, max_length ) };
+		}
+
+	private:
+		void publish(std::vector< std::uint64_t >& batch, std::uint64_t lines)
+		{
+			{
+				std::lock_guard lock{ mtx_ };
+				checkpoints_.insert( checkpoints_.end(), batch.begin(), batch.end() );
+			}
+			batch.clear();
+			lines_.store( lines, std::memory_order_release );
+			notify();
+		}
+
+		void notify()
+		{
+			if( on_progress_ ) {
+				on_progress_();
+			}
+		}
+
+		void run() noexcept
+		{
+			try {
+				build();
+			}
+			catch( ... ) {
+				{
+					std::lock_guard lock{ mtx_ };
+					error_ = std::current_exception();
+				}
+				notify();
+			}
+		}
+
+		void build()
+		{
+			auto const file_size = file_->size();
+			if( file_size == 0 ) {
+				complete_.store( true, std::memory_order_release );
+				notify();
+				return;
+			}
+
+			std::vector< std::uint64_t > batch;
+			batch.push_back( 0 );
+			std::uint64_t lines = 1;
+
+			for( std::uint64_t base = 0; base < file_size && !stop_.load( std::memory_order_relaxed ); base += view_size ) {
+				auto const v = file_->view( base, view_size );
+
+				for( std::size_t pos = 0; pos < v.size(); ) {
+					auto const end = std::min( pos + publish_size, v.size() );
+					while( pos < end ) {
+						auto const p = static_cast< char const* >( std::memchr( v.data() + pos, '\n', end - pos ) );
+						if( !p ) {
+							pos = end;
+							break;
+						}
+
+						pos = static_cast< std::size_t >( p - v.data() ) + 1;
+						if( base + pos < file_size ) {
+							if( lines % stride == 0 ) {
+								batch.push_back( base + pos );
+							}
+							++lines;
+						}
+					}
+					publish( batch, lines );
+
+					if( stop_.load( std::memory_order_relaxed ) ) {
+						return;
+					}
+				}
+			}
+
+			complete_.store( true, std::memory_order_release );
+			notify();
+		}
+	};
+
+} // namespace detail
+
+} // namespace musket
+
+#endif // MUSKET_DETAIL_LINE_INDEX_HPP_
\ No newline at end of file
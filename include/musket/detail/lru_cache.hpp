@@ -0,0 +1,123 @@
+//--------------------------------------------------------
+// musket/include/musket/detail/lru_cache.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_DETAIL_LRU_CACHE_HPP_
+#define MUSKET_DETAIL_LRU_CACHE_HPP_
+
+#include <list>
+#include <utility>
+#include <functional>
+#include <unordered_map>
+
+namespace musket {
+
+namespace detail {
+
+	template <typename Key, typename Value, typename Hash = std::hash< Key >>
+	class lru_cache
+	{
+		using list_type = std::list< std::pair< Key, Value > >;
+
+		list_type items_;
+		std::unordered_map< Key, typename list_type::iterator, Hash > index_;
+		std::size_t capacity_;
+
+	public:
+		explicit lru_cache(std::size_t capacity) :
+			capacity_{ capacity > 0 ? capacity : 1 }
+		{
+			index_.reserve( capacity_ );
+		}
+
+		std::size_t size() const noexcept
+		{
+			return items_.size();
+		}
+
+		std::size_t capacity() const noexcept
+		{
+			return capacity_;
+		}
+
+		void set_capacity(std::size_t capacity)
+		{
+			capacity_ = capacity > 0 ? capacity : 1;
+			while( items_.size() > capacity_ ) {
+				index_.erase( items_.back().first );
+				items_.pop_back();
+			}
+			index_.reserve( capacity_ );
+		}
+
+		Value* find(Key const& key)
+		{
+			auto const itr = index_.find( key );
+			if( itr == index_.end() ) {
+				return nullptr;
+			}
+
+			items_.splice( items_.begin(), items_, itr->second );
+			return &itr->second->second;
+		}
+
+		Value& insert(Key const& key, Value value)
+		{
+			if( auto const itr = index_.find( key ); itr != index_.end() ) {
+				items_.splice( items_.begin(), items_, itr->second );
+				itr->second->second = std::move( value );
+				return itr->second->second;
+			}
+
+			if( items_.size() >= capacity_ ) {
+				auto const last = std::prev( items_.end() );
+				index_.erase( last->first );
+				items_.splice( items_.begin(), items_, last );
+				items_.front().first = key;
+				items_.front().second = std::move( value );
+			}
+			else {
+				items_.emplace_front( key, std::move( value ) );
+			}
+
+			index_.emplace( key, items_.begin() );
+			return items_.front().second;
+		}
+
+		template <typename F>
+		Value& get_or_insert(Key const& key, F&& f)
+		{
+			if( auto const p = find( key ) ) {
+				return *p;
+			}
+			return insert( key, f() );
+		}
+
+		void erase(Key const& key)
+		{
+			auto const itr = index_.find( key );
+			if( itr == index_.end() ) {
+				return;
+			}
+
+			items_.erase( itr->second );
+			index_.erase( itr );
+		}
+
+		void clear() noexcept
+		{
+			items_.clear();
+			index_.clear();
+		}
+	};
+
+} // namespace detail
+
+} // namespace musket
+
+#endif // MUSKET_DETAIL_LRU_CACHE_HPP_
\ No newline at end of file
@@ -0,0 +1,176 @@
+//--------------------------------------------------------
+// musket/include/musket/detail/mapped_file.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_DETAIL_MAPPED_FILE_HPP_
+#define MUSKET_DETAIL_MAPPED_FILE_HPP_
+
+#include <cstdint>
+#include <utility>
+#include <string_view>
+#include <spirea/windows/api.hpp>
+#include <spirea/windows/undef.hpp>
+
+namespace musket {
+
+namespace detail {
+
+	inline spirea::windows::hresult_error last_error() noexcept
+	{
+		return spirea::windows::hresult_error( HRESULT_FROM_WIN32( GetLastError() ) );
+	}
+
+	class mapped_view
+	{
+		void* base_ = nullptr;
+		char const* data_ = nullptr;
+		std::size_t size_ = 0;
+
+	public:
+		mapped_view() = default;
+
+		mapped_view(void* base, char const* data, std::size_t size) noexcept :
+			base_{ base },
+			data_{ data },
+			size_{ size }
+		{ }
+
+		mapped_view(mapped_view&& other) noexcept :
+			base_{ std::exchange( other.base_, nullptr ) },
+			data_{ std::exchange( other.data_, nullptr ) },
+			size_{ std::exchange( other.size_, 0 ) }
+		{ }
+
+		mapped_view& operator=(mapped_view&& other) noexcept
+		{
+			if( this != &other ) {
+				reset();
+				base_ = std::exchange( other.base_, nullptr );
+				data_ = std::exchange( other.data_, nullptr );
+				size_ = std::exchange( other.size_, 0 );
+			}
+			return *this;
+		}
+
+		~mapped_view() noexcept
+		{
+			reset();
+		}
+
+		char const* data() const noexcept
+		{
+			return data_;
+		}
+
+		std::size_t size() const noexcept
+		{
+			return size_;
+		}
+
+		void reset() noexcept
+		{
+			if( base_ ) {
+				UnmapViewOfFile( base_ );
+				base_ = nullptr;
+				data_ = nullptr;
+				size_ = 0;
+			}
+		}
+	};
+
+	class file_mapping
+	{
+		HANDLE file_ = INVALID_HANDLE_VALUE;
+		HANDLE mapping_ = nullptr;
+		std::uint64_t size_ = 0;
+		std::uint64_t granularity_ = 0;
+
+	public:
+		explicit file_mapping(std::string_view path)
+		{
+			auto const wpath = spirea::windows::multibyte_to_widechar( spirea::windows::code_page::utf8, path );
+			file_ = CreateFileW(
+				wpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+				OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+			);
+			if( file_ == INVALID_HANDLE_VALUE ) {
+				throw last_error();
+			}
+
+			LARGE_INTEGER sz;
+			if( !GetFileSizeEx( file_, &sz ) ) {
+				auto const e = last_error();
+				CloseHandle( file_ );
+				throw e;
+			}
+			size_ = static_cast< std::uint64_t >( sz.QuadPart );
+
+			if( size_ > 0 ) {
+				mapping_ = CreateFileMappingW( file_, nullptr, PAGE_READONLY, 0, 0, nullptr );
+				if( !mapping_ ) {
+					auto const e = last_error();
+					CloseHandle( file_ );
+					throw e;
+				}
+			}
+
+			SYSTEM_INFO si;
+			GetSystemInfo( &si );
+			granularity_ = si.dwAllocationGranularity;
+		}
+
+		file_mapping(file_mapping const&) = delete;
+		file_mapping& operator=(file_mapping const&) = delete;
+
+		~file_mapping() noexcept
+		{
+			if( mapping_ ) {
+				CloseHandle( mapping_ );
+			}
+			CloseHandle( file_ );
+		}
+
+		std::uint64_t size() const noexcept
+		{
+			return size_;
+		}
+
+		mapped_view view(std::uint64_t offset, std::size_t length) const
+		{
+			if( offset >= size_ || length == 0 ) {
+				return {};
+			}
+			if( length > size_ - offset ) {
+				length = static_cast< std::size_t >( size_ - offset );
+			}
+
+			auto const aligned = offset - offset % granularity_;
+			auto const bias = static_cast< std::size_t >( offset - aligned );
+			auto const p = MapViewOfFile(
+				mapping_, FILE_MAP_READ,
+				static_cast< DWORD >( aligned >> 32 ), static_cast< DWORD >( aligned & 0xffffffff ),
+				length + bias
+			);
+			if( !p ) {
+				throw last_error();
+			}
+
+			return { p, static_cast< char const* >( p ) + bias, length };
+		}
+
+		mapped_view view() const
+		{
+			return view( 0, static_cast< std::size_t >( size_ ) );
+		}
+	};
+
+} // namespace detail
+
+} // namespace musket
+
+#endif // MUSKET_DETAIL_MAPPED_FILE_HPP_
\ No newline at end of file
@@ -0,0 +1,127 @@
+//--------------------------------------------------------
+// musket/include/musket/detail/mpsc_queue.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_DETAIL_MPSC_QUEUE_HPP_
+#define MUSKET_DETAIL_MPSC_QUEUE_HPP_
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <utility>
+
+namespace musket {
+
+namespace detail {
+
+	template <typename T>
+	class mpsc_queue
+	{
+		struct cell
+		{
+			std::atomic< std::size_t > seq;
+			T data;
+		};
+
+		static constexpr std::size_t cache_line = 64;
+
+		std::unique_ptr< cell[] > buf_;
+		std::size_t mask_;
+		alignas( cache_line ) std::atomic< std::size_t > enqueue_pos_{ 0 };
+		alignas( cache_line ) std::size_t dequeue_pos_ = 0;
+
+	public:
+		explicit mpsc_queue(std::size_t capacity)
+		{
+			std::size_t sz = 2;
+			while( sz < capacity ) {
+				sz <<= 1;
+			}
+
+			buf_.reset( new cell[sz] );
+			mask_ = sz - 1;
+			for( std::size_t i = 0; i < sz; ++i ) {
+				buf_[i].seq.store( i, std::memory_order_relaxed );
+			}
+		}
+
+		mpsc_queue(mpsc_queue const&) = delete;
+		mpsc_queue& operator=(mpsc_queue const&) = delete;
+
+		std::size_t capacity() const noexcept
+		{
+			return mask_ + 1;
+		}
+
+		template <typename U>
+		bool try_push(U&& v)
+		{
+			cell* c;
+			auto pos = enqueue_pos_.load( std::memory_order_relaxed );
+
+			for( ;; ) {
+				c = &buf_[pos & mask_];
+				auto const seq = c->seq.load( std::memory_order_acquire );
+				auto const diff = static_cast< std::intptr_t >( seq ) - static_cast< std::intptr_t >( pos );
+
+				if( diff == 0 ) {
+					if( enqueue_pos_.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+						break;
+					}
+				}
+				else if( diff < 0 ) {
+					return false;
+				}
+				else {
+					pos = enqueue_pos_.load( std::memory_order_relaxed );
+				}
+			}
+
+			c->data = std::forward< U >( v );
+			c->seq.store( pos + 1, std::memory_order_release );
+			return true;
+		}
+
+		bool try_pop(T& v)
+		{
+			auto& c = buf_[dequeue_pos_ & mask_];
+			auto const seq = c.seq.load( std::memory_order_acquire );
+			if( static_cast< std::intptr_t >( seq ) - static_cast< std::intptr_t >( dequeue_pos_ + 1 ) < 0 ) {
+				return false;
+			}
+
+			v = std::move( c.data );
+			c.seq.store( dequeue_pos_ + mask_ + 1, std::memory_order_release );
+			++dequeue_pos_;
+			return true;
+		}
+
+		template <typename F>
+		std::size_t consume(F&& f, std::size_t max_count)
+		{
+			std::size_t n = 0;
+			T v;
+			while( n < max_count && try_pop( v ) ) {
+				f( std::move( v ) );
+				++n;
+			}
+			return n;
+		}
+
+		bool empty() const noexcept
+		{
+			auto const& c = buf_[dequeue_pos_ & mask_];
+			return static_cast< std::intptr_t >( c.seq.load( std::memory_order_acquire ) ) - static_cast< std::intptr_t >( dequeue_pos_ + 1 ) < 0;
+		}
+	};
+
+} // namespace detail
+
+} // namespace musket
+
+#endif // MUSKET_DETAIL_MPSC_QUEUE_HPP_
\ No newline at end of file
@@ -0,0 +1,133 @@
+//--------------------------------------------------------
+// musket/include/musket/detail/offscreen_target.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_DETAIL_OFFSCREEN_TARGET_HPP_
+#define MUSKET_DETAIL_OFFSCREEN_TARGET_HPP_
+
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <spirea/windows/d2d1.hpp>
+#include "wic.hpp"
+#include "../context.hpp"
+#include "../bitmap.hpp"
+
+namespace musket {
+
+namespace detail {
+
+	class offscreen_target
+	{
+		com_ptr< IWICBitmap > bitmap_;
+		spirea::d2d1::render_target rt_;
+		float width_;
+		float height_;
+		float dpi_;
+		std::uint32_t pixel_width_;
+		std::uint32_t pixel_height_;
+
+	public:
+		offscreen_target(float width, float height, float dpi = 96.0f) :
+			width_{ width },
+			height_{ height },
+			dpi_{ dpi },
+			pixel_width_{ static_cast< std::uint32_t >( std::ceil( width * dpi / 96.0f ) ) },
+			pixel_height_{ static_cast< std::uint32_t >( std::ceil( height * dpi / 96.0f ) ) }
+		{
+			spirea::windows::try_hresult( wic_factory()->CreateBitmap(
+				pixel_width_, pixel_height_, GUID_WICPixelFormat32bppPBGRA, WICBitmapCacheOnDemand, bitmap_.pp()
+			) );
+			spirea::windows::try_hresult( context().d2d1->CreateWicBitmapRenderTarget(
+				bitmap_.get(),
+				D2D1::RenderTargetProperties(
+					D2D1_RENDER_TARGET_TYPE_SOFTWARE,
+					D2D1::PixelFormat( DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED ),
+					dpi, dpi
+				),
+				rt_.pp()
+			) );
+			rt_->SetTextAntialiasMode( D2D1_TEXT_ANTIALIAS_MODE_GRAYSCALE );
+		}
+
+		spirea::d2d1::render_target const& render_target() const noexcept
+		{
+			return rt_;
+		}
+
+		IWICBitmap* bitmap() const noexcept
+		{
+			return bitmap_.get();
+		}
+
+		spirea::rect_t< float > size() const noexcept
+		{
+			return { { 0.0f, 0.0f }, { width_, height_ } };
+		}
+
+		float dpi() const noexcept
+		{
+			return dpi_;
+		}
+
+		std::uint32_t width() const noexcept
+		{
+			return pixel_width_;
+		}
+
+		std::uint32_t height() const noexcept
+		{
+			return pixel_height_;
+		}
+
+		void copy_to(bitmap_view const& dst) const
+		{
+			if( dst.width != pixel_width_ || dst.height != pixel_height_ || dst.stride < pixel_width_ * 4 ) {
+				throw std::invalid_argument( "bitmap_view does not match the size of the rendered frame" );
+			}
+
+			WICRect const rc = { 0, 0, static_cast< INT >( pixel_width_ ), static_cast< INT >( pixel_height_ ) };
+			com_ptr< IWICBitmapLock > lock;
+			spirea::windows::try_hresult( bitmap_->Lock( &rc, WICBitmapLockRead, lock.pp() ) );
+
+			UINT stride = 0;
+			UINT size = 0;
+			BYTE* data = nullptr;
+			spirea::windows::try_hresult( lock->GetStride( &stride ) );
+			spirea::windows::try_hresult( lock->GetDataPointer( &size, &data ) );
+
+			auto const bytes = pixel_width_ * 4;
+			if( dst.stride == bytes && stride == bytes ) {
+				std::memcpy( dst.data, data, static_cast< std::size_t >( bytes ) * pixel_height_ );
+				return;
+			}
+			for( std::uint32_t y = 0; y < pixel_height_; ++y ) {
+				std::memcpy( dst.data + static_cast< std::size_t >( y ) * dst.stride, data + static_cast< std::size_t >( y ) * stride, bytes );
+			}
+		}
+
+		bitmap to_bitmap() const
+		{
+			bitmap bmp{ pixel_width_, pixel_height_ };
+			copy_to( bmp.view() );
+			return bmp;
+		}
+
+		std::vector< std::uint32_t > pixels() const
+		{
+			return to_bitmap().pixels();
+		}
+	};
+
+} // namespace detail
+
+} // namespace musket
+
+#endif // MUSKET_DETAIL_OFFSCREEN_TARGET_HPP_
\ No newline at end of file
@@ -0,0 +1,295 @@
+//--------------------------------------------------------
+// musket/include/musket/detail/piece_table.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_DETAIL_PIECE_TABLE_HPP_
+#define MUSKET_DETAIL_PIECE_TABLE_HPP_
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cassert>
+#include <algorithm>
+#include <string_view>
+
+namespace musket {
+
+namespace detail {
+
+	class piece_table
+	{
+		struct buffer
+		{
+			std::string text;
+			std::vector< std::size_t > breaks;
+
+			void append(std::string_view s)
+			{
+				auto const base = text.size();
+				text.append( s.begin(), s.end() );
+				for( auto p = s.data(); ( p = static_cast< char const* >( std::memchr( p, '\n', s.data() + s.size() - p ) ) ) != nullptr; ++p ) {
+					breaks.push_back( base + static_cast< std::size_t >( p - s.data() ) );
+				}
+			}
+
+			std::size_t count_breaks(std::size_t first, std::size_t last) const noexcept
+			{
+				auto const b = std::lower_bound( breaks.begin(), breaks.end(), first );
+				auto const e = std::lower_bound( b, breaks.end(), last );
+				return static_cast< std::size_t >( e - b );
+			}
+
+			std::size_t nth_break(std::size_t first, std::size_t n) const noexcept
+			{
+				auto const b = std::lower_bound( breaks.begin(), breaks.end(), first );
+				return *( b + n );
+			}
+		};
+
+		struct piece
+		{
+			bool added;
+			std::size_t offset;
+			std::size_t length;
+			std::size_t breaks;
+		};
+
+		buffer original_;
+		buffer added_;
+		std::vector< piece > pieces_;
+		std::size_t size_ = 0;
+		std::size_t breaks_ = 0;
+
+	public:
+		piece_table() = default;
+
+		explicit piece_table(std::string_view text)
+		{
+			original_.append( text );
+			if( !text.empty() ) {
+				pieces_.push_back( { false, 0, text.size(), original_.breaks.size() } );
+			}
+			size_ = text.size();
+			breaks_ = original_.breaks.size();
+		}
+
+		std::size_t size() const noexcept
+		{
+			return size_;
+		}
+
+		std::size_t size_of_lines() const noexcept
+		{
+			return breaks_ + 1;
+		}
+
+		std::size_t size_of_pieces() const noexcept
+		{
+			return pieces_.size();
+		}
+
+		void insert(std::size_t pos, std::string_view s)
+		{
+			assert( pos <= size_ );
+			if( s.empty() ) {
+				return;
+			}
+
+			auto const offset = added_.text.size();
+			added_.append( s );
+			piece const p = { true, offset, s.size(), added_.count_breaks( offset, offset + s.size() ) };
+
+			auto [itr, in] = find( pos );
+			if( in == 0 ) {
+				if( itr != pieces_.begin() ) {
+					auto& prev = *std::prev( itr );
+					if( prev.added && prev.offset + prev.length == offset ) {
+						prev.length += p.length;
+						prev.breaks += p.breaks;
+						size_ += p.length;
+						breaks_ += p.breaks;
+						return;
+					}
+				}
+				pieces_.insert( itr, p );
+			}
+			else {
+				auto const tail = split( *itr, in );
+				itr = pieces_.insert( std::next( itr ), p );
+				pieces_.insert( std::next( itr ), tail );
+			}
+
+			size_ += p.length;
+			breaks_ += p.breaks;
+		}
+
+		void erase(std::size_t pos, std::size_t n)
+		{
+			assert( pos + n <= size_ );
+			if( n == 0 ) {
+				return;
+			}
+
+			auto [itr, in] = find( pos );
+			if( in > 0 ) {
+				auto const tail = split( *itr, in );
+				itr = pieces_.insert( std::next( itr ), tail );
+			}
+
+			auto rest = n;
+			auto last = itr;
+			while( rest > 0 && last != pieces_.end() ) {
+				if( last->length <= rest ) {
+					rest -= last->length;
+					breaks_ -= last->breaks;
+					++last;
+				}
+				else {
+					auto const head_breaks = buffer_of( *last ).count_breaks( last->offset, last->offset + rest );
+					breaks_ -= head_breaks;
+					last->offset += rest;
+					last->length -= rest;
+					last->breaks -= head_breaks;
+					rest = 0;
+				}
+			}
+
+			pieces_.erase( itr, last );
+			size_ -= n;
+		}
+
+		std::size_t line_start(std::size_t line) const noexcept
+		{
+			if( line == 0 ) {
+				return 0;
+			}
+			if( line > breaks_ ) {
+				return size_;
+			}
+
+			std::size_t pos = 0;
+			std::size_t acc = 0;
+			for( auto const& p : pieces_ ) {
+				if( acc + p.breaks >= line ) {
+					auto const br = buffer_of( p ).nth_break( p.offset, line - acc - 1 );
+					return pos + ( br - p.offset ) + 1;
+				}
+				acc += p.breaks;
+				pos += p.length;
+			}
+
+			return size_;
+		}
+
+		std::size_t line_of(std::size_t position) const noexcept
+		{
+			std::size_t pos = 0;
+			std::size_t acc = 0;
+			for( auto const& p : pieces_ ) {
+				if( position < pos + p.length ) {
+					return acc + buffer_of( p ).count_breaks( p.offset, p.offset + ( position - pos ) );
+				}
+				acc += p.breaks;
+				pos += p.length;
+			}
+
+			return breaks_;
+		}
+
+		char at(std::size_t position) const noexcept
+		{
+			assert( position < size_ );
+
+			std::size_t pos = 0;
+			for( auto const& p : pieces_ ) {
+				if( position < pos + p.length ) {
+					return buffer_of( p ).text[p.offset + ( position - pos )];
+				}
+				pos += p.length;
+			}
+
+			return '\0';
+		}
+
+		std::string text(std::size_t first, std::size_t n) const
+		{
+			std::string s;
+			s.reserve( n );
+
+			std::size_t pos = 0;
+			for( auto const& p : pieces_ ) {
+				if( n == 0 ) {
+					break;
+				}
+				if( first < pos + p.length ) {
+					auto const in = first > pos ? first - pos : 0;
+					auto const len = std::min( p.length - in, n );
+					s.append( buffer_of( p ).text, p.offset + in, len );
+					first += len;
+					n -= len;
+				}
+				pos += p.length;
+			}
+
+			return s;
+		}
+
+		std::string line(std::size_t n) const
+		{
+			auto const first = line_start( n );
+			auto last = n + 1 < size_of_lines() ? line_start( n + 1 ) - 1 : size_;
+
+			auto s = text( first, last - first );
+			if( !s.empty() && s.back() == '\r' ) {
+				s.pop_back();
+			}
+			return s;
+		}
+
+		std::string str() const
+		{
+			return text( 0, size_ );
+		}
+
+	private:
+		buffer const& buffer_of(piece const& p) const noexcept
+		{
+			return p.added ? added_ : original_;
+		}
+
+		std::pair< std::vector< piece >::iterator, std::size_t > find(std::size_t position)
+		{
+			std::size_t pos = 0;
+			for( auto itr = pieces_.begin(); itr != pieces_.end(); ++itr ) {
+				if( position < pos + itr->length ) {
+					return { itr, position - pos };
+				}
+				pos += itr->length;
+			}
+
+			return { pieces_.end(), 0 };
+		}
+
+		piece split(piece& p, std::size_t in)
+		{
+			auto const& buf = buffer_of( p );
+			auto const head_breaks = buf.count_breaks( p.offset, p.offset + in );
+
+			piece const tail = { p.added, p.offset + in, p.length - in, p.breaks - head_breaks };
+			p.length = in;
+			p.breaks = head_breaks;
+
+			return tail;
+		}
+	};
+
+} // namespace detail
+
+} // namespace musket
+
+#endif // MUSKET_DETAIL_PIECE_TABLE_HPP_
\ No newline at end of file
@@ -0,0 +1,100 @@
+//--------------------------------------------------------
+// musket/include/musket/detail/thread_pool.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_DETAIL_THREAD_POOL_HPP_
+#define MUSKET_DETAIL_THREAD_POOL_HPP_
+
+#include <mutex>
+#include <deque>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+namespace musket {
+
+namespace detail {
+
+	class thread_pool
+	{
+		std::mutex mtx_;
+		std::condition_variable cv_;
+		std::deque< std::function< void () > > tasks_;
+		std::vector< std::thread > threads_;
+		bool stop_ = false;
+
+	public:
+		explicit thread_pool(std::size_t n = std::max( std::thread::hardware_concurrency(), 1u ))
+		{
+			threads_.reserve( n );
+			for( std::size_t i = 0; i < n; ++i ) {
+				threads_.emplace_back( [this] { run(); } );
+			}
+		}
+
+		thread_pool(thread_pool const&) = delete;
+		thread_pool& operator=(thread_pool const&) = delete;
+
+		~thread_pool() noexcept
+		{
+			{
+				std::lock_guard lock{ mtx_ };
+				stop_ = true;
+			}
+			cv_.notify_all();
+			for( auto& t : threads_ ) {
+				t.join();
+			}
+		}
+
+		std::size_t size() const noexcept
+		{
+			return threads_.size();
+		}
+
+		void submit(std::function< void () > f)
+		{
+			{
+				std::lock_guard lock{ mtx_ };
+				tasks_.push_back( std::move( f ) );
+			}
+			cv_.notify_one();
+		}
+
+	private:
+		void run()
+		{
+			for( ;; ) {
+				std::function< void () > f;
+				{
+					std::unique_lock lock{ mtx_ };
+					cv_.wait( lock, [this] { return stop_ || !tasks_.empty(); } );
+					if( tasks_.empty() ) {
+						return;
+					}
+					f = std::move( tasks_.front() );
+					tasks_.pop_front();
+				}
+				f();
+			}
+		}
+	};
+
+	inline thread_pool& default_thread_pool()
+	{
+		static thread_pool pool;
+		return pool;
+	}
+
+} // namespace detail
+
+} // namespace musket
+
+#endif // MUSKET_DETAIL_THREAD_POOL_HPP_
\ No newline at end of file
@@ -0,0 +1,267 @@
+//--------------------------------------------------------
+// musket/include/musket/detail/timer_wheel.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_DETAIL_TIMER_WHEEL_HPP_
+#define MUSKET_DETAIL_TIMER_WHEEL_HPP_
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include <functional>
+
+namespace musket {
+
+	struct timer_handle
+	{
+		std::uint32_t index = ~0u;
+		std::uint32_t generation = 0;
+	};
+
+namespace detail {
+
+	template <typename... Args>
+	class timer_wheel
+	{
+		static constexpr std::uint32_t npos = ~0u;
+		static constexpr std::uint64_t slot_bits = 8;
+		static constexpr std::uint64_t slots = 1 << slot_bits;
+		static constexpr std::uint64_t slot_mask = slots - 1;
+		static constexpr std::uint64_t levels = 4;
+		static constexpr std::uint64_t max_delta = ( std::uint64_t{ 1 } << ( slot_bits * levels ) ) - 1;
+
+		struct node
+		{
+			std::function< void (Args...) > f;
+			std::uint64_t deadline = 0;
+			std::uint64_t period = 0;
+			std::uint32_t prev = npos;
+			std::uint32_t next = npos;
+			std::uint32_t slot = npos;
+			std::uint32_t generation = 0;
+			bool active = false;
+		};
+
+		std::vector< node > nodes_;
+		std::vector< std::uint32_t > free_;
+		std::array< std::uint32_t, slots * levels > heads_;
+		std::vector< timer_handle > batch_;
+		std::uint64_t now_ = 0;
+		std::size_t size_ = 0;
+
+	public:
+		timer_wheel()
+		{
+			heads_.fill( npos );
+		}
+
+		std::uint64_t now() const noexcept
+		{
+			return now_;
+		}
+
+		std::size_t size() const noexcept
+		{
+			return size_;
+		}
+
+		template <typename F>
+		timer_handle schedule(std::uint64_t delay, F&& f, std::uint64_t period = 0)
+		{
+			std::uint32_t i;
+			if( free_.empty() ) {
+				i = static_cast< std::uint32_t >( nodes_.size() );
+				nodes_.emplace_back();
+			}
+			else {
+				i = free_.back();
+				free_.pop_back();
+			}
+
+			auto& n = nodes_[i];
+			n.f = std::forward< F >( f );
+			n.deadline = now_ + std::max< std::uint64_t >( delay, 1 );
+			n.period = period;
+			n.active = true;
+			link( i );
+			++size_;
+
+			return { i, n.generation };
+		}
+
+		bool is_active(timer_handle h) const noexcept
+		{
+			return h.index < nodes_.size() && nodes_[h.index].generation == h.generation && nodes_[h.index].active;
+		}
+
+		bool cancel(timer_handle h) noexcept
+		{
+			if( !is_active( h ) ) {
+				return false;
+			}
+
+			unlink( h.index );
+			release( h.index );
+			return true;
+		}
+
+		std::optional< std::uint64_t > next_deadline() const noexcept
+		{
+			if( size_ == 0 ) {
+				return std::nullopt;
+			}
+
+			std::optional< std::uint64_t > result;
+			for( std::uint64_t level = 0; level < levels; ++level ) {
+				auto const shift = slot_bits * level;
+				auto const base = now_ >> shift;
+				for( std::uint64_t k = 1; k <= slots; ++k ) {
+					auto const t = base + k;
+					if( heads_[level * slots + ( t & slot_mask )] != npos ) {
+						auto const tick = t << shift;
+						if( !result || tick < *result ) {
+							result = tick;
+						}
+						break;
+					}
+				}
+			}
+
+			return result;
+		}
+
+		std::size_t advance(std::uint64_t now, Args... args)
+		{
+			if( size_ == 0 ) {
+				now_ = std::max( now_, now );
+				return 0;
+			}
+
+			batch_.clear();
+			while( now_ < now ) {
+				++now_;
+				for( std::uint64_t level = 1; level < levels && ( now_ & ( ( std::uint64_t{ 1 } << ( slot_bits * level ) ) - 1 ) ) == 0; ++level ) {
+					cascade( level * slots + ( ( now_ >> ( slot_bits * level ) ) & slot_mask ) );
+				}
+				expire( now_ & slot_mask );
+
+				if( size_ == batch_.size() ) {
+					now_ = now;
+				}
+			}
+
+			std::size_t fired = 0;
+			for( auto const h : batch_ ) {
+				if( h.index >= nodes_.size() || nodes_[h.index].generation != h.generation ) {
+					continue;
+				}
+
+				auto& n = nodes_[h.index];
+				auto f = std::move( n.f );
+				if( n.period > 0 ) {
+					n.deadline = std::max( n.deadline + n.period, now_ + 1 );
+					link( h.index );
+					f( args... );
+					if( is_active( h ) ) {
+						nodes_[h.index].f = std::move( f );
+					}
+				}
+				else {
+					release( h.index );
+					f( args... );
+				}
+				++fired;
+			}
+
+			return fired;
+		}
+
+	private:
+		void link(std::uint32_t i) noexcept
+		{
+			auto& n = nodes_[i];
+			auto const delta = n.deadline > now_ ? n.deadline - now_ : 0;
+			auto const at = now_ + std::min( delta, max_delta );
+
+			std::uint64_t level = 0;
+			while( level + 1 < levels && delta >= ( std::uint64_t{ 1 } << ( slot_bits * ( level + 1 ) ) ) ) {
+				++level;
+			}
+
+			auto const slot = static_cast< std::uint32_t >( level * slots + ( ( at >> ( slot_bits * level ) ) & slot_mask ) );
+			n.slot = slot;
+			n.prev = npos;
+			n.next = heads_[slot];
+			if( n.next != npos ) {
+				nodes_[n.next].prev = i;
+			}
+			heads_[slot] = i;
+		}
+
+		void unlink(std::uint32_t i) noexcept
+		{
+			auto& n = nodes_[i];
+			if( n.slot == npos ) {
+				return;
+			}
+
+			if( n.prev != npos ) {
+				nodes_[n.prev].next = n.next;
+			}
+			else {
+				heads_[n.slot] = n.next;
+			}
+			if( n.next != npos ) {
+				nodes_[n.next].prev = n.prev;
+			}
+			n.prev = n.next = n.slot = npos;
+		}
+
+		void release(std::uint32_t i)
+		{
+			auto& n = nodes_[i];
+			n.f = nullptr;
+			n.active = false;
+			++n.generation;
+			free_.push_back( i );
+			--size_;
+		}
+
+		void cascade(std::uint64_t slot)
+		{
+			auto i = heads_[slot];
+			heads_[slot] = npos;
+			while( i != npos ) {
+				auto const next = nodes_[i].next;
+				nodes_[i].slot = npos;
+				link( i );
+				i = next;
+			}
+		}
+
+		void expire(std::uint64_t slot)
+		{
+			auto i = heads_[slot];
+			while( i != npos ) {
+				auto const next = nodes_[i].next;
+				if( nodes_[i].deadline <= now_ ) {
+					unlink( i );
+					batch_.push_back( { i, nodes_[i].generation } );
+				}
+				i = next;
+			}
+		}
+	};
+
+} // namespace detail
+
+} // namespace musket
+
+#endif // MUSKET_DETAIL_TIMER_WHEEL_HPP_
\ No newline at end of file
@@ -0,0 +1,131 @@
+//--------------------------------------------------------
+// musket/include/musket/detail/wic.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_DETAIL_WIC_HPP_
+#define MUSKET_DETAIL_WIC_HPP_
+
+#include <utility>
+#include <spirea/windows/api.hpp>
+#include <objbase.h>
+#include <wincodec.h>
+#include <spirea/windows/undef.hpp>
+
+namespace musket {
+
+namespace detail {
+
+	template <typename T>
+	class com_ptr
+	{
+		T* p_ = nullptr;
+
+	public:
+		com_ptr() = default;
+
+		com_ptr(com_ptr const& other) noexcept :
+			p_{ other.p_ }
+		{
+			if( p_ ) {
+				p_->AddRef();
+			}
+		}
+
+		com_ptr(com_ptr&& other) noexcept :
+			p_{ std::exchange( other.p_, nullptr ) }
+		{ }
+
+		com_ptr& operator=(com_ptr const& other) noexcept
+		{
+			com_ptr{ other }.swap( *this );
+			return *this;
+		}
+
+		com_ptr& operator=(com_ptr&& other) noexcept
+		{
+			com_ptr{ std::move( other ) }.swap( *this );
+			return *this;
+		}
+
+		~com_ptr() noexcept
+		{
+			reset();
+		}
+
+		void reset() noexcept
+		{
+			if( p_ ) {
+				std::exchange( p_, nullptr )->Release();
+			}
+		}
+
+		void swap(com_ptr& other) noexcept
+		{
+			std::swap( p_, other.p_ );
+		}
+
+		T* get() const noexcept
+		{
+			return p_;
+		}
+
+		T** pp() noexcept
+		{
+			reset();
+			return &p_;
+		}
+
+		T* operator->() const noexcept
+		{
+			return p_;
+		}
+
+		explicit operator bool() const noexcept
+		{
+			return p_ != nullptr;
+		}
+	};
+
+	class com_scope
+	{
+		bool initialized_;
+
+	public:
+		com_scope() noexcept :
+			initialized_{ SUCCEEDED( CoInitializeEx( nullptr, COINIT_MULTITHREADED ) ) }
+		{ }
+
+		~com_scope() noexcept
+		{
+			if( initialized_ ) {
+				CoUninitialize();
+			}
+		}
+
+		com_scope(com_scope const&) = delete;
+		com_scope& operator=(com_scope const&) = delete;
+	};
+
+	inline IWICImagingFactory* wic_factory()
+	{
+		thread_local com_scope com;
+		thread_local com_ptr< IWICImagingFactory > factory = [] {
+			com_ptr< IWICImagingFactory > f;
+			spirea::windows::try_hresult( CoCreateInstance(
+				CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS( f.pp() )
+			) );
+			return f;
+		}();
+		return factory.get();
+	}
+
+} // namespace detail
+
+} // namespace musket
+
+#endif // MUSKET_DETAIL_WIC_HPP_
\ No newline at end of file
@@ -10,7 +10,14 @@
 #ifndef MUSKET_DETAIL_WINDOW_IMPL_HPP_
 #define MUSKET_DETAIL_WINDOW_IMPL_HPP_
 
+#include <cmath>
+#include <vector>
+#include <utility>
+#include <optional>
+#include <algorithm>
 #include "../window.hpp"
+#include "mpsc_queue.hpp"
+#include "timer_wheel.hpp"
 #include <spirea/mp/algorithm.hpp>
 
 namespace musket {
@@ -19,36 +26,75 @@ namespace musket {
 
 namespace detail {
 
-	struct window_context
+	constexpr std::size_t task_queue_capacity = 4096;
+
+	struct window_context :
+		std::enable_shared_from_this< window_context >
 	{
 		spirea::windows::window wnd;
 		spirea::d2d1::hwnd_render_target rt;
+		spirea::d2d1::render_target target;
+		spirea::d2d1::bitmap_render_target bg_layer;
 		spirea::d2d1::color_f bg_color;
 		event_handler< window, window_events, detail::event_handler_element_to_widget > to_widget_handler;
 		event_handler< window, default_window_events > events_handler;
+		mpsc_queue< std::function< void (window&) > > tasks{ task_queue_capacity };
+		std::atomic< std::int64_t > pending_tasks{ 0 };
+		std::atomic< bool > wake_failed{ false };
+		std::chrono::microseconds task_budget{ 4000 };
+		timer_wheel< window& > timers;
+		std::chrono::steady_clock::time_point timer_origin = std::chrono::steady_clock::now();
+		std::shared_ptr< animator > animations = std::make_shared< animator >();
+		std::uint64_t target_generation = 0;
+		window_stats stats;
+		draw_profiler profiler;
+		std::optional< input_recording > recording;
+		std::uint64_t recording_origin = 0;
+		std::optional< input_replay > replay;
+		invalidation_counters invalidations;
+		std::unique_ptr< offscreen_target > offscreen;
+		std::vector< spirea::rect_t< float > > pending_rects;
+		std::shared_ptr< widget_arena > arena;
+		bool pending_full_redraw = true;
+		invalidation_scope* redraw_scope = nullptr;
 
 		bool mouse_entered = false;
+		bool idle_frame_requested = false;
+		wchar_t high_surrogate = 0;
+		bool bg_layer_dirty = true;
 
 		template <typename Rect, typename Color, typename T>
-		window_context(Rect const& rc, std::string_view caption, Color const& bg_color, T) :
+		window_context(Rect const& rc, std::string_view caption, Color const& bg_color, T type) :
 			bg_color{ rgba_color_traits< spirea::d2d1::color_f >::construct( bg_color ) }
 		{ 
-			auto trc = spirea::rect_traits< RECT >::construct( rc );
-			auto const dpi = spirea::try_result( spirea::windows::api::get_dpi_for_monitor( 
-				spirea::windows::api::monitor_from_point( { trc.left, trc.top } ) 
-			) );
-			constexpr auto default_dpi = spirea::windows::api::user_default_screen_dpi< LONG >;
+			if constexpr( std::is_same_v< T, window_type::offscreen > ) {
+				auto const src = spirea::rect_traits< spirea::rect_t< float > >::construct( rc );
+				offscreen = std::make_unique< offscreen_target >( src.width(), src.height(), type.dpi );
+			}
+			else {
+				auto trc = spirea::rect_traits< RECT >::construct( rc );
+				auto const dpi = spirea::try_result( spirea::windows::api::get_dpi_for_monitor( 
+					spirea::windows::api::monitor_from_point( { trc.left, trc.top } ) 
+				) );
+				constexpr auto default_dpi = spirea::windows::api::user_default_screen_dpi< LONG >;
 
-			auto const width = spirea::width( trc ) * static_cast< LONG >( dpi.x ) / default_dpi;
-			auto const height = spirea::height( trc ) * static_cast< LONG >( dpi.y ) / default_dpi;
+				auto const width = spirea::width( trc ) * static_cast< LONG >( dpi.x ) / default_dpi;
+				auto const height = spirea::height( trc ) * static_cast< LONG >( dpi.y ) / default_dpi;
 
-			wnd = { caption, T::style, T::ex_style, trc.left, trc.top, width, height };
+				wnd = { caption, T::style, T::ex_style, trc.left, trc.top, width, height };
+			}
 
 			recreate_target();
 		}
 
 		void recreate_target()
 		{
+			if( offscreen ) {
+				target = offscreen->render_target();
+				++target_generation;
+				return;
+			}
+
 			rt.reset();
 			auto const rc = wnd.get_client_rect();
 			
@@ -56,17 +102,407 @@ namespace detail {
 				D2D1::RenderTargetProperties(),
 				D2D1::HwndRenderTargetProperties( 
 					wnd.handle(), 
-					spirea::area_traits< D2D1_SIZE_U >::construct( spirea::area( rc ) )
+					spirea::area_traits< D2D1_SIZE_U >::construct( spirea::area( rc ) ),
+					D2D1_PRESENT_OPTIONS_RETAIN_CONTENTS
 				),
 				rt.pp()
 			) );
 
 			float const dpi = static_cast< float >( spirea::windows::api::get_dpi_for_window( wnd ) );
 			rt->SetDpi( dpi, dpi );
+
+			target = rt;
+			bg_layer.reset();
+			bg_layer_dirty = true;
+			++target_generation;
+		}
+
+		void recreate_background_layer()
+		{
+			bg_layer.reset();
+			spirea::windows::try_hresult( rt->CreateCompatibleRenderTarget( bg_layer.pp() ) );
+			bg_layer_dirty = true;
+		}
+
+		HRESULT draw_background_layer(window& w)
+		{
+			if( !bg_layer ) {
+				recreate_background_layer();
+			}
+			if( !bg_layer_dirty ) {
+				return S_OK;
+			}
+
+			auto color = bg_color;
+			color.a = 1.0f;
+
+			target = bg_layer;
+			bg_layer->BeginDraw();
+			bg_layer->Clear( color );
+			to_widget_handler.invoke( event::detail::draw_static{}, w );
+			auto const res = bg_layer->EndDraw();
+			target = rt;
+
+			bg_layer_dirty = res != S_OK;
+			return res;
+		}
+
+		window owner() noexcept
+		{
+			return window{ shared_from_this() };
+		}
+
+		bool wake() noexcept
+		{
+			if( offscreen || PostMessageW( wnd.handle(), wm_run_tasks, 0, 0 ) ) {
+				return true;
+			}
+
+			wake_failed.store( true, std::memory_order_release );
+			return false;
+		}
+
+		void run_tasks(window& w)
+		{
+			auto const deadline = std::chrono::steady_clock::now() + task_budget;
+
+			stats_scope scope{ stats, stats_event::tasks };
+
+			std::function< void (window&) > f;
+			while( tasks.try_pop( f ) ) {
+				pending_tasks.fetch_sub( 1, std::memory_order_acq_rel );
+				f( w );
+				if( std::chrono::steady_clock::now() >= deadline ) {
+					break;
+				}
+			}
+
+			if( pending_tasks.load( std::memory_order_acquire ) > 0 ) {
+				wake();
+			}
+		}
+
+		std::uint64_t elapsed_ms() const noexcept
+		{
+			return static_cast< std::uint64_t >(
+				std::chrono::duration_cast< std::chrono::milliseconds >( std::chrono::steady_clock::now() - timer_origin ).count()
+			);
+		}
+
+		void run_timers()
+		{
+			stats_scope scope{ stats, stats_event::timers };
+			auto w = owner();
+			timers.advance( elapsed_ms(), w );
+		}
+
+		std::uint64_t elapsed_us() const noexcept
+		{
+			return static_cast< std::uint64_t >(
+				std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::steady_clock::now() - timer_origin ).count()
+			);
+		}
+
+		float elapsed_time() const noexcept
+		{
+			return std::chrono::duration< float, std::milli >( std::chrono::steady_clock::now() - timer_origin ).count();
+		}
+
+		bool redirect_redraw(std::optional< spirea::rect_t< float > > const& rc)
+		{
+			auto const scope = redraw_scope;
+			if( !scope ) {
+				return false;
+			}
+
+			redraw_scope = scope->prev_;
+			scope->f_( rc );
+			redraw_scope = scope;
+			return true;
+		}
+
+		spirea::point_t< float > scope_origin() const noexcept
+		{
+			spirea::point_t< float > pt = { 0.0f, 0.0f };
+			for( auto s = redraw_scope; s; s = s->prev_ ) {
+				pt.x += s->origin_.x;
+				pt.y += s->origin_.y;
+			}
+			return pt;
+		}
+
+		void invalidate(spirea::rect_t< float > const& rc) noexcept
+		{
+			stats.redraw_requested();
+			++invalidations.requests;
+			invalidations.area += std::max( rc.right - rc.left, 0.0f ) * std::max( rc.bottom - rc.top, 0.0f );
+			if( offscreen ) {
+				pending_rects.push_back( rc );
+				return;
+			}
+
+			auto const dpi = static_cast< float >( spirea::windows::api::get_dpi_for_window( wnd ) );
+			constexpr auto default_dpi = spirea::windows::api::user_default_screen_dpi< float >;
+
+			RECT const prc = {
+				static_cast< LONG >( std::floor( rc.left * dpi / default_dpi ) ) - 1,
+				static_cast< LONG >( std::floor( rc.top * dpi / default_dpi ) ) - 1,
+				static_cast< LONG >( std::ceil( rc.right * dpi / default_dpi ) ) + 1,
+				static_cast< LONG >( std::ceil( rc.bottom * dpi / default_dpi ) ) + 1,
+			};
+			InvalidateRect( wnd.handle(), &prc, FALSE );
+		}
+
+		void arm_frame_timer() noexcept
+		{
+			if( offscreen ) {
+				return;
+			}
+
+			std::optional< std::uint64_t > delay;
+			if( idle_frame_requested || wake_failed.load( std::memory_order_acquire ) ) {
+				delay = 0;
+			}
+			else if( auto const deadline = timers.next_deadline() ) {
+				auto const now = elapsed_ms();
+				delay = *deadline > now ? *deadline - now : 0;
+			}
+
+			if( !delay ) {
+				KillTimer( wnd.handle(), frame_timer_id );
+				return;
+			}
+			SetTimer( 
+				wnd.handle(), frame_timer_id, 
+				static_cast< UINT >( std::clamp< std::uint64_t >( *delay, USER_TIMER_MINIMUM, USER_TIMER_MAXIMUM ) ), 
+				nullptr 
+			);
+		}
+
+		void run_frame_timer()
+		{
+			if( wake_failed.exchange( false, std::memory_order_acq_rel ) ) {
+				auto w = owner();
+				run_tasks( w );
+			}
+			run_timers();
+			if( std::exchange( idle_frame_requested, false ) ) {
+				idle();
+			}
+			arm_frame_timer();
+		}
+
+		void run_animations()
+		{
+			if( animations->advance( elapsed_time(), [this](spirea::rect_t< float > const& rc) { invalidate( rc ); } ) ) {
+				idle_frame_requested = true;
+			}
+		}
+
+		template <typename Event>
+		void dispatch_mouse_button(Event, stats_event id, input_record const& r)
+		{
+			stats.input_arrived( window_stats::now() );
+			stats_scope scope{ stats, id };
+
+			auto w = owner();
+			events_handler.invoke( Event{}, w, r.button, r.buttons, r.position );
+			to_widget_handler.invoke( Event{}, r.position, w, r.button, r.buttons, r.position );
+		}
+
+		void dispatch_input(input_record r)
+		{
+			if( recording ) {
+				r.time_us = elapsed_us() - recording_origin;
+				recording->push_back( r );
+			}
+
+			auto w = owner();
+			switch( r.kind ) {
+			case input_kind::mouse_button_pressed:
+				dispatch_mouse_button( event::mouse_button_pressed{}, stats_event::mouse_button_pressed, r );
+				break;
+			case input_kind::mouse_button_released:
+				dispatch_mouse_button( event::mouse_button_released{}, stats_event::mouse_button_released, r );
+				events_handler.shrink_to_fit( event::mouse_moved{} );
+				break;
+			case input_kind::mouse_moved: {
+				stats.input_arrived( window_stats::now() );
+				stats_scope scope{ stats, stats_event::mouse_moved };
+				events_handler.invoke( event::mouse_moved{}, w, r.buttons, r.position );
+				to_widget_handler.invoke( event::detail::mouse_moved_distributor{}, r.position, w, r.buttons );
+				break;
+			}
+			case input_kind::mouse_leaved:
+				to_widget_handler.invoke( event::detail::mouse_moved_distributor{}, event::mouse_leaved{}, w, r.buttons );
+				break;
+			case input_kind::key_pressed: {
+				stats.input_arrived( window_stats::now() );
+				stats_scope scope{ stats, stats_event::key_pressed };
+				auto const key = static_cast< virtual_key >( r.code );
+				events_handler.invoke( event::key_pressed{}, w, key );
+				to_widget_handler.invoke( event::key_pressed{}, w, key );
+				break;
+			}
+			case input_kind::char_input: {
+				stats.input_arrived( window_stats::now() );
+				stats_scope scope{ stats, stats_event::char_input };
+				auto const ch = static_cast< char32_t >( r.code );
+				events_handler.invoke( event::char_input{}, w, ch );
+				to_widget_handler.invoke( event::char_input{}, w, ch );
+				break;
+			}
+			}
+			stats.input_handled();
+		}
+
+		void run_replay()
+		{
+			if( !replay ) {
+				return;
+			}
+
+			if( replay->speed == replay_speed::as_fast_as_possible ) {
+				if( replay->next < replay->recording.size() ) {
+					dispatch_input( replay->recording.records()[replay->next++] );
+				}
+			}
+			else {
+				auto const t = elapsed_us() - replay->origin;
+				while( replay && replay->next < replay->recording.size() && replay->recording.records()[replay->next].time_us <= t ) {
+					dispatch_input( replay->recording.records()[replay->next++] );
+				}
+			}
+
+			if( !replay ) {
+				return;
+			}
+			if( replay->next < replay->recording.size() ) {
+				idle_frame_requested = true;
+			}
+			else {
+				replay.reset();
+			}
+		}
+
+		void idle()
+		{
+			run_replay();
+			run_animations();
+
+			stats_scope scope{ stats, stats_event::idle };
+			auto w = owner();
+			events_handler.invoke( event::idle{}, w );
+			to_widget_handler.invoke( event::idle{}, w );
+		}
+
+		HRESULT draw(window& w, spirea::rect_t< float > const& clip)
+		{
+			auto const res = draw_background_layer( w );
+			if( res != S_OK ) {
+				return res;
+			}
+
+			spirea::d2d1::bitmap bg;
+			spirea::windows::try_hresult( bg_layer->GetBitmap( bg.pp() ) );
+
+			rt->BeginDraw();
+			rt->PushAxisAlignedClip( spirea::rect_traits< spirea::d2d1::rect_f >::construct( clip ), D2D1_ANTIALIAS_MODE_ALIASED );
+			rt->DrawBitmap( bg.get(), nullptr, 1.0f, D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR, nullptr );
+
+			{
+				stats_scope scope{ stats, stats_event::draw };
+				events_handler.invoke( event::draw{}, w );
+				to_widget_handler.invoke( event::draw{}, w );
+			}
+			profiler.draw_overlay( rt, target_generation );
+
+			rt->PopAxisAlignedClip();
+			return rt->EndDraw();
+		}
+
+		void render_to(window& w, spirea::d2d1::render_target const& dst)
+		{
+			bool const foreign = dst.get() != target.get();
+			auto const prev = target;
+			target = dst;
+			if( foreign ) {
+				++target_generation;
+			}
+
+			auto color = bg_color;
+			color.a = 1.0f;
+
+			dst->BeginDraw();
+			dst->Clear( color );
+			to_widget_handler.invoke( event::detail::draw_static{}, w );
+			events_handler.invoke( event::draw{}, w );
+			to_widget_handler.invoke( event::draw{}, w );
+			auto const res = dst->EndDraw();
+
+			target = prev;
+			if( foreign ) {
+				++target_generation;
+			}
+
+			spirea::windows::try_hresult( res );
+		}
+
+		void render_pending(window& w)
+		{
+			if( std::exchange( pending_full_redraw, false ) ) {
+				pending_rects.clear();
+				render_to( w, offscreen->render_target() );
+				return;
+			}
+			if( pending_rects.empty() ) {
+				return;
+			}
+
+			auto const rects = std::move( pending_rects );
+			pending_rects.clear();
+
+			auto const& dst = offscreen->render_target();
+			auto const scale = offscreen->dpi() / spirea::windows::api::user_default_screen_dpi< float >;
+			auto color = bg_color;
+			color.a = 1.0f;
+
+			dst->BeginDraw();
+			for( auto const& rc : rects ) {
+				D2D1_RECT_F const clip = {
+					( std::floor( rc.left * scale ) - 1.0f ) / scale,
+					( std::floor( rc.top * scale ) - 1.0f ) / scale,
+					( std::ceil( rc.right * scale ) + 1.0f ) / scale,
+					( std::ceil( rc.bottom * scale ) + 1.0f ) / scale,
+				};
+				dst->PushAxisAlignedClip( clip, D2D1_ANTIALIAS_MODE_ALIASED );
+				dst->Clear( color );
+				to_widget_handler.invoke( event::detail::draw_static{}, w );
+				events_handler.invoke( event::draw{}, w );
+				to_widget_handler.invoke( event::draw{}, w );
+				dst->PopAxisAlignedClip();
+			}
+			spirea::windows::try_hresult( dst->EndDraw() );
+		}
+
+		template <typename F>
+		auto snapshot(window& w, spirea::rect_t< float > const& client, F&& read)
+		{
+			if( offscreen ) {
+				run_tasks( w );
+				run_timers();
+				idle();
+				render_pending( w );
+				return read( *offscreen );
+			}
+
+			offscreen_target t{ client.width(), client.height(), static_cast< float >( spirea::windows::api::get_dpi_for_window( wnd ) ) };
+			render_to( w, t.render_target() );
+			return read( t );
 		}
 	};
 
-	inline void conect_mouse_events(window& wnd, std::shared_ptr< window_context > wc)
+	inline void conect_mouse_events(std::shared_ptr< window_context > wc)
 	{
 		auto mouse_position = [](spirea::windows::window const& w, LPARAM lparam) -> spirea::point_t< std::int32_t > {
 			auto const dpi = spirea::windows::api::get_dpi_for_window( w );
@@ -77,47 +513,48 @@ namespace detail {
 			};
 		};
 
-		auto invoker = [wnd, wc, mouse_position](auto event, mouse_button btn, spirea::windows::window const& w, WPARAM wparam, LPARAM lparam) mutable {
-			auto const pt = mouse_position( w, lparam );
-			wc->events_handler.invoke( decltype( event ){}, wnd, btn, static_cast< mouse_button >( wparam ), pt );
-			wc->to_widget_handler.invoke( decltype( event ){}, pt, wnd, btn, static_cast< mouse_button >( wparam ), pt );
-			return 0;
+		auto mouse_record = [mouse_position](input_kind kind, mouse_button btn, spirea::windows::window const& w, WPARAM wparam, LPARAM lparam) {
+			input_record r;
+			r.kind = kind;
+			r.button = btn;
+			r.buttons = static_cast< mouse_button >( wparam );
+			r.position = mouse_position( w, lparam );
+			return r;
 		};
 
-		auto pressed_event = [invoker](auto event, mouse_button btn, spirea::windows::window const& w, WPARAM wparam, LPARAM lparam) mutable {
-			auto const res = invoker( decltype( event ){}, btn, w, wparam, lparam );
+		auto pressed_event = [wc, mouse_record](mouse_button btn, spirea::windows::window const& w, WPARAM wparam, LPARAM lparam) {
+			wc->dispatch_input( mouse_record( input_kind::mouse_button_pressed, btn, w, wparam, lparam ) );
 			SetCapture( w.handle() );
-			return res;
+			return 0;
 		};
 
-		auto released_event = [wc, invoker](auto event, mouse_button btn, spirea::windows::window const& w, WPARAM wparam, LPARAM lparam) mutable {
-			auto const res = invoker( decltype( event ){}, btn, w, wparam, lparam );
+		auto released_event = [wc, mouse_record](mouse_button btn, spirea::windows::window const& w, WPARAM wparam, LPARAM lparam) {
+			wc->dispatch_input( mouse_record( input_kind::mouse_button_released, btn, w, wparam, lparam ) );
 			ReleaseCapture();
-			wc->events_handler.shrink_to_fit( event::mouse_moved{} );
-			return res;
+			return 0;
 		};
 
-		wc->wnd.connect( WM_LBUTTONDOWN, [pressed_event](spirea::windows::window wnd, WPARAM wparam, LPARAM lparam) mutable {
-			return pressed_event( event::mouse_button_pressed{}, mouse_button::left, wnd, wparam, lparam );
+		wc->wnd.connect( WM_LBUTTONDOWN, [pressed_event](spirea::windows::window wnd, WPARAM wparam, LPARAM lparam) {
+			return pressed_event( mouse_button::left, wnd, wparam, lparam );
 		} );
-		wc->wnd.connect( WM_RBUTTONDOWN, [pressed_event](spirea::windows::window wnd, WPARAM wparam, LPARAM lparam) mutable {
-			return pressed_event( event::mouse_button_pressed{}, mouse_button::right, wnd, wparam, lparam );
+		wc->wnd.connect( WM_RBUTTONDOWN, [pressed_event](spirea::windows::window wnd, WPARAM wparam, LPARAM lparam) {
+			return pressed_event( mouse_button::right, wnd, wparam, lparam );
 		} );
-		wc->wnd.connect( WM_MBUTTONDOWN, [pressed_event](spirea::windows::window wnd, WPARAM wparam, LPARAM lparam) mutable {
-			return pressed_event( event::mouse_button_pressed{}, mouse_button::middle, wnd, wparam, lparam );
+		wc->wnd.connect( WM_MBUTTONDOWN, [pressed_event](spirea::windows::window wnd, WPARAM wparam, LPARAM lparam) {
+			return pressed_event( mouse_button::middle, wnd, wparam, lparam );
 		} );
 
-		wc->wnd.connect( WM_LBUTTONUP, [released_event](spirea::windows::window wnd, WPARAM wparam, LPARAM lparam) mutable {
-			return released_event( event::mouse_button_released{}, mouse_button::left, wnd, wparam, lparam );
+		wc->wnd.connect( WM_LBUTTONUP, [released_event](spirea::windows::window wnd, WPARAM wparam, LPARAM lparam) {
+			return released_event( mouse_button::left, wnd, wparam, lparam );
 		} );
-		wc->wnd.connect( WM_RBUTTONUP, [released_event](spirea::windows::window wnd, WPARAM wparam, LPARAM lparam) mutable {
-			return released_event( event::mouse_button_released{}, mouse_button::right, wnd, wparam, lparam );
+		wc->wnd.connect( WM_RBUTTONUP, [released_event](spirea::windows::window wnd, WPARAM wparam, LPARAM lparam) {
+			return released_event( mouse_button::right, wnd, wparam, lparam );
 		} );
-		wc->wnd.connect( WM_MBUTTONUP, [released_event](spirea::windows::window wnd, WPARAM wparam, LPARAM lparam) mutable {
-			return released_event( event::mouse_button_released{}, mouse_button::middle, wnd, wparam, lparam );
+		wc->wnd.connect( WM_MBUTTONUP, [released_event](spirea::windows::window wnd, WPARAM wparam, LPARAM lparam) {
+			return released_event( mouse_button::middle, wnd, wparam, lparam );
 		} );
 
-		wc->wnd.connect( WM_MOUSEMOVE, [wnd, wc, mouse_position](spirea::windows::window w, WPARAM wparam, LPARAM lparam) mutable {
+		wc->wnd.connect( WM_MOUSEMOVE, [wc, mouse_record](spirea::windows::window w, WPARAM wparam, LPARAM lparam) {
 			if( !wc->mouse_entered ) {
 				TRACKMOUSEEVENT tm = {};
 				tm.cbSize = sizeof( TRACKMOUSEEVENT );
@@ -129,59 +566,185 @@ namespace detail {
 				wc->mouse_entered = true;
 			}
 
-			auto const pt = mouse_position( w, lparam );
-			wc->events_handler.invoke( event::mouse_moved{}, wnd, static_cast< mouse_button >( wparam ), pt );
-			wc->to_widget_handler.invoke( event::detail::mouse_moved_distributor{}, pt, wnd, static_cast< mouse_button >( wparam ) );
+			wc->dispatch_input( mouse_record( input_kind::mouse_moved, mouse_button::none, w, wparam, lparam ) );
 			return 0;
 		} );
 
-		wc->wnd.connect( WM_MOUSELEAVE, [wnd, wc](spirea::windows::window, WPARAM, LPARAM) mutable {
-			wc->to_widget_handler.invoke( event::detail::mouse_moved_distributor{}, event::mouse_leaved{}, wnd, get_mouse_button_states() );
+		wc->wnd.connect( WM_MOUSELEAVE, [wc](spirea::windows::window, WPARAM, LPARAM) {
+			input_record r;
+			r.kind = input_kind::mouse_leaved;
+			r.buttons = get_mouse_button_states();
+			wc->dispatch_input( r );
 			wc->mouse_entered = false;
 			return 0;
 		} );
 	}
 
+	inline void connect_key_events(std::shared_ptr< window_context > wc)
+	{
+		wc->wnd.connect( WM_KEYDOWN, [wc](spirea::windows::window, WPARAM wparam, LPARAM) {
+			input_record r;
+			r.kind = input_kind::key_pressed;
+			r.code = static_cast< std::uint32_t >( wparam );
+			wc->dispatch_input( r );
+			return 0;
+		} );
+
+		wc->wnd.connect( WM_CHAR, [wc](spirea::windows::window, WPARAM wparam, LPARAM) {
+			auto const c = static_cast< wchar_t >( wparam );
+			if( IS_HIGH_SURROGATE( c ) ) {
+				wc->high_surrogate = c;
+				return 0;
+			}
+
+			auto ch = static_cast< char32_t >( c );
+			if( IS_LOW_SURROGATE( c ) ) {
+				if( !wc->high_surrogate ) {
+					return 0;
+				}
+				ch = 0x10000 + ( ( static_cast< char32_t >( wc->high_surrogate ) - 0xd800 ) << 10 ) + ( ch - 0xdc00 );
+			}
+			wc->high_surrogate = 0;
+
+			input_record r;
+			r.kind = input_kind::char_input;
+			r.code = static_cast< std::uint32_t >( ch );
+			wc->dispatch_input( r );
+			return 0;
+		} );
+	}
+
+	inline std::vector< std::weak_ptr< window_context > >& window_registry()
+	{
+		thread_local std::vector< std::weak_ptr< window_context > > windows;
+		return windows;
+	}
+
+	inline bool dispatch_idle_frames()
+	{
+		auto& reg = window_registry();
+		reg.erase( std::remove_if( reg.begin(), reg.end(), [](auto const& wp) { return wp.expired(); } ), reg.end() );
+
+		std::vector< std::shared_ptr< window_context > > requested;
+		for( auto const& wp : reg ) {
+			auto wc = wp.lock();
+			if( wc && wc->idle_frame_requested ) {
+				wc->idle_frame_requested = false;
+				requested.push_back( std::move( wc ) );
+			}
+		}
+
+		for( auto const& wc : requested ) {
+			wc->idle();
+		}
+
+		return std::any_of( reg.begin(), reg.end(), [](auto const& wp) {
+			auto const wc = wp.lock();
+			return wc && wc->idle_frame_requested;
+		} );
+	}
+
+	inline bool retry_failed_wakes()
+	{
+		std::vector< std::shared_ptr< window_context > > windows;
+		for( auto const& wp : window_registry() ) {
+			if( auto wc = wp.lock(); wc && wc->wake_failed.exchange( false, std::memory_order_acq_rel ) ) {
+				windows.push_back( std::move( wc ) );
+			}
+		}
+
+		for( auto const& wc : windows ) {
+			auto w = wc->owner();
+			wc->run_tasks( w );
+		}
+
+		return !windows.empty();
+	}
+
+	inline void invalidate_widget(std::weak_ptr< window_context > const& wc, spirea::rect_t< float > const& rc) noexcept
+	{
+		if( auto const p = wc.lock() ) {
+			p->owner().redraw( rc );
+		}
+	}
+
+	inline void forget_widget(std::shared_ptr< window_context > const& wc, void const* instance) noexcept
+	{
+		wc->profiler.forget( instance );
+	}
+
+	inline void invalidate_background_layer(std::shared_ptr< window_context > const& wc) noexcept
+	{
+		wc->bg_layer_dirty = true;
+		if( wc->offscreen ) {
+			wc->pending_full_redraw = true;
+		}
+		else {
+			spirea::windows::api::invalidate_rect( wc->wnd, nullptr, false );
+		}
+	}
+
 } // namespace detail
 
 	template <typename Rect, typename Color, typename T>
-	inline window::window(Rect const& rc, std::string_view caption,  Color const& bg_color, T) :
-		p_{ std::make_shared< detail::window_context >( rc, caption, bg_color, T{} ) }
+	inline window::window(Rect const& rc, std::string_view caption,  Color const& bg_color, T type) :
+		p_{ std::make_shared< detail::window_context >( rc, caption, bg_color, type ) }
 	{
-		detail::conect_mouse_events( *this, p_ ); 
+		if constexpr( std::is_same_v< T, window_type::offscreen > ) {
+			detail::window_registry().push_back( p_ );
+			return;
+		}
+
+		detail::conect_mouse_events( p_ ); 
+		detail::connect_key_events( p_ );
+
+		auto const wc = p_.get();
 
-		p_->wnd.connect( WM_PAINT, [this](spirea::windows::window, WPARAM, LPARAM) -> LRESULT {
-			auto ps = spirea::windows::api::begin_paint( p_->wnd.handle() );
+		p_->wnd.connect( WM_PAINT, [wc](spirea::windows::window, WPARAM, LPARAM) -> LRESULT {
+			auto const paint_start = detail::window_stats::now();
+			auto w = wc->owner();
 
-			p_->rt->BeginDraw();
-			p_->rt->Clear( p_->bg_color );
+			RECT update;
+			if( !GetUpdateRect( wc->wnd.handle(), &update, FALSE ) ) {
+				update = wc->wnd.get_client_rect();
+			}
+			auto ps = spirea::windows::api::begin_paint( wc->wnd.handle() );
 
-			p_->events_handler.invoke( event::draw{}, *this );
-			p_->to_widget_handler.invoke( event::draw{}, *this );
+			auto const dpi = static_cast< float >( spirea::windows::api::get_dpi_for_window( wc->wnd ) );
+			constexpr auto default_dpi = spirea::windows::api::user_default_screen_dpi< float >;
+			auto clip = spirea::rect_traits< spirea::rect_t< float > >::construct( update );
+			clip.left = clip.left * default_dpi / dpi;
+			clip.top = clip.top * default_dpi / dpi;
+			clip.right = clip.right * default_dpi / dpi;
+			clip.bottom = clip.bottom * default_dpi / dpi;
 
-			auto const res = p_->rt->EndDraw();
+			auto const res = wc->draw( w, clip );
 			if( res != S_OK ) {
 				if( res == D2DERR_RECREATE_TARGET ) {
-					p_->recreate_target();
-					p_->events_handler.invoke( event::recreated_target{}, *this );
-					p_->to_widget_handler.invoke( event::recreated_target{}, *this );
+					wc->recreate_target();
+					wc->events_handler.invoke( event::recreated_target{}, w );
+					w.redraw();
 				}
 				else {
 					throw spirea::windows::hresult_error( res );
 				}
 			}
+			wc->stats.painted( paint_start );
 
 			return 0;
 		} );
 
-		p_->wnd.connect( WM_SIZE, [this](spirea::windows::window, WPARAM, LPARAM lparam) -> LRESULT {
-			auto const rc = p_->wnd.get_client_rect();
+		p_->wnd.connect( WM_SIZE, [wc](spirea::windows::window, WPARAM, LPARAM lparam) -> LRESULT {
+			auto w = wc->owner();
+			auto const rc = wc->wnd.get_client_rect();
 			auto const width = static_cast< std::uint32_t >( spirea::width( rc ) );
 			auto const height = static_cast< std::uint32_t >( spirea::height( rc ) );
 
-			spirea::windows::try_hresult( p_->rt->Resize( { width, height } ) );
+			spirea::windows::try_hresult( wc->rt->Resize( { width, height } ) );
+			wc->bg_layer.reset();
+			wc->bg_layer_dirty = true;
 
-			auto const dpi = spirea::windows::api::get_dpi_for_window( p_->wnd );
+			auto const dpi = spirea::windows::api::get_dpi_for_window( wc->wnd );
 			constexpr auto default_dpi = spirea::windows::api::user_default_screen_dpi< std::uint32_t >;
 
 			spirea::area_t< std::uint32_t > sz = {
@@ -189,16 +752,18 @@ namespace detail {
 				height * default_dpi / dpi,
 			};
 
-			p_->events_handler.invoke( event::resized{}, *this, sz );
-			p_->to_widget_handler.invoke( event::resized{}, *this, sz );
+			detail::stats_scope scope{ wc->stats, stats_event::resized };
+			wc->events_handler.invoke( event::resized{}, w, sz );
+			wc->to_widget_handler.invoke( event::resized{}, w, sz );
 
 			return 0;
 		} );
 
-		p_->wnd.connect( WM_SIZING, [this](spirea::windows::window, WPARAM wparam, LPARAM lparam) -> LRESULT {
-			auto const prev_rc = spirea::rect_traits< spirea::rect_t< float > >::construct( p_->wnd.get_window_rect() );
+		p_->wnd.connect( WM_SIZING, [wc](spirea::windows::window, WPARAM wparam, LPARAM lparam) -> LRESULT {
+			auto w = wc->owner();
+			auto const prev_rc = spirea::rect_traits< spirea::rect_t< float > >::construct( wc->wnd.get_window_rect() );
 			auto const next_rc = spirea::rect_traits< spirea::rect_t< float > >::construct( *reinterpret_cast< RECT* >( lparam ) );
-			auto const dpi = spirea::windows::api::get_dpi_for_window( p_->wnd );
+			auto const dpi = spirea::windows::api::get_dpi_for_window( wc->wnd );
 			constexpr auto default_dpi = spirea::windows::api::user_default_screen_dpi< float >;
 
 			auto const offset = spirea::point_t{ 
@@ -206,26 +771,50 @@ namespace detail {
 				( next_rc.height() - prev_rc.height() ) * default_dpi / dpi,
 			};
 
-			p_->to_widget_handler.invoke( event::detail::auto_resize{}, *this, offset );
-			p_->to_widget_handler.invoke( event::detail::auto_relocation{}, *this, offset );
+			wc->to_widget_handler.invoke( event::detail::auto_resize{}, w, offset );
+			wc->to_widget_handler.invoke( event::detail::auto_relocation{}, w, offset );
 
-			return DefWindowProcW( p_->wnd.handle(), WM_SIZING, wparam, lparam );
+			return DefWindowProcW( wc->wnd.handle(), WM_SIZING, wparam, lparam );
 		} );
 
-		p_->wnd.connect( WM_DPICHANGED, [this](spirea::windows::window, WPARAM, LPARAM lparam) -> LRESULT {
+		p_->wnd.connect( WM_DPICHANGED, [wc](spirea::windows::window, WPARAM, LPARAM lparam) -> LRESULT {
 			auto const& rc = *reinterpret_cast< RECT const* >( lparam );
-			SetWindowPos( p_->wnd.handle(), nullptr, rc.left, rc.top, spirea::width( rc ), spirea::height( rc ), SWP_NOZORDER | SWP_NOACTIVATE );
+			SetWindowPos( wc->wnd.handle(), nullptr, rc.left, rc.top, spirea::width( rc ), spirea::height( rc ), SWP_NOZORDER | SWP_NOACTIVATE );
+
+			auto const dpi = spirea::windows::api::get_dpi_for_window( wc->wnd );
+			wc->rt->SetDpi( static_cast< float >( dpi ), static_cast< float >( dpi ) );
+			wc->bg_layer.reset();
+			wc->bg_layer_dirty = true;
 
-			auto const dpi = spirea::windows::api::get_dpi_for_window( p_->wnd );
-			p_->rt->SetDpi( static_cast< float >( dpi ), static_cast< float >( dpi ) );
+			return 0;
+		} );
 
+		p_->wnd.connect( detail::wm_run_tasks, [wc](spirea::windows::window, WPARAM, LPARAM) -> LRESULT {
+			auto w = wc->owner();
+			wc->run_tasks( w );
 			return 0;
 		} );
 
-		p_->wnd.connect_idle( [this](spirea::windows::window) {
-			p_->events_handler.invoke( event::idle{}, *this );
-			p_->to_widget_handler.invoke( event::idle{}, *this );
+		p_->wnd.connect( detail::wm_request_frame, [wc](spirea::windows::window, WPARAM, LPARAM) -> LRESULT {
+			wc->idle_frame_requested = true;
+			wc->arm_frame_timer();
+			return 0;
+		} );
+
+		p_->wnd.connect( WM_TIMER, [wc](spirea::windows::window, WPARAM wparam, LPARAM) -> LRESULT {
+			if( wparam == detail::frame_timer_id ) {
+				wc->run_frame_timer();
+			}
+			return 0;
 		} );
+
+		p_->wnd.connect_idle( [wc](spirea::windows::window) {
+			detail::retry_failed_wakes();
+			wc->run_timers();
+			wc->idle();
+		} );
+
+		detail::window_registry().push_back( p_ );
 	}
 
 	inline void window::show() noexcept
@@ -243,17 +832,100 @@ namespace detail {
 	inline void window::redraw() const noexcept
 	{
 		assert( p_ );
-		spirea::windows::api::invalidate_rect( p_->wnd, nullptr, false );
+		if( p_->redirect_redraw( std::nullopt ) ) {
+			return;
+		}
+
+		p_->stats.redraw_requested();
+		auto const rc = client_area_size();
+		++p_->invalidations.requests;
+		++p_->invalidations.full_redraws;
+		p_->invalidations.area += rc.width() * rc.height();
+		if( p_->offscreen ) {
+			p_->pending_full_redraw = true;
+		}
+		else {
+			spirea::windows::api::invalidate_rect( p_->wnd, nullptr, false );
+		}
+	}
+
+	template <typename Rect>
+	inline void window::redraw(Rect const& rc) const noexcept
+	{
+		assert( p_ );
+		auto const frc = spirea::rect_traits< spirea::rect_t< float > >::construct( rc );
+		if( p_->redirect_redraw( frc ) ) {
+			return;
+		}
+
+		p_->invalidate( frc );
+	}
+
+	inline void window::redraw_background() const noexcept
+	{
+		assert( p_ );
+		p_->bg_layer_dirty = true;
+		redraw();
+	}
+
+	template <typename F>
+	inline timer_handle window::set_timer(std::chrono::milliseconds delay, F&& f)
+	{
+		assert( p_ );
+		auto const h = p_->timers.schedule( static_cast< std::uint64_t >( delay.count() ), std::forward< F >( f ) );
+		p_->arm_frame_timer();
+		return h;
+	}
+
+	template <typename F>
+	inline timer_handle window::set_interval(std::chrono::milliseconds period, F&& f)
+	{
+		assert( p_ );
+		auto const t = static_cast< std::uint64_t >( period.count() );
+		auto const h = p_->timers.schedule( t, std::forward< F >( f ), std::max< std::uint64_t >( t, 1 ) );
+		p_->arm_frame_timer();
+		return h;
+	}
+
+	inline bool window::cancel_timer(timer_handle h) noexcept
+	{
+		assert( p_ );
+		return p_->timers.cancel( h );
+	}
+
+	template <typename Rect>
+	inline animation window::animate(float from, float to, std::chrono::milliseconds duration, Rect const& bounds, easing e)
+	{
+		assert( p_ );
+		auto const i = p_->animations->start(
+			from, to, p_->elapsed_time(), static_cast< float >( duration.count() ),
+			spirea::rect_traits< spirea::rect_t< float > >::construct( bounds ), e
+		);
+		request_idle_frame();
+		return { p_->animations, i };
+	}
+
+	inline void window::request_idle_frame() const noexcept
+	{
+		assert( p_ );
+		p_->idle_frame_requested = true;
+		p_->arm_frame_timer();
 	}
 
 	inline void window::close() noexcept 
 	{
 		assert( p_ );
-		p_->wnd.close();
+		if( !p_->offscreen ) {
+			p_->wnd.close();
+		}
 	}
 
 	spirea::rect_t< float > window::client_area_size() const noexcept
 	{
+		if( p_->offscreen ) {
+			return p_->offscreen->size();
+		}
+
 		auto rc = spirea::rect_traits< spirea::rect_t< float > >::construct( p_->wnd.get_client_rect() );
 		auto const dpi = spirea::windows::api::get_dpi_for_window( p_->wnd );
 		constexpr auto default_dpi = spirea::windows::api::user_default_screen_dpi< float >;
@@ -270,31 +942,323 @@ namespace detail {
 		return p_->wnd;
 	}
 
-	inline spirea::d2d1::hwnd_render_target window::render_target() const noexcept
+	inline spirea::d2d1::render_target window::render_target() const noexcept
+	{
+		assert( p_ );
+		return p_->target;
+	}
+
+	inline frame_stats window::stats() const
 	{
 		assert( p_ );
-		return p_->rt;
+		return p_->stats.snapshot();
+	}
+
+	inline void window::set_draw_profiling(bool enabled) noexcept
+	{
+		assert( p_ );
+		p_->profiler.enable( enabled );
+	}
+
+	inline void window::show_draw_cost_overlay(bool visible) noexcept
+	{
+		assert( p_ );
+		p_->profiler.show_overlay( visible );
+		redraw();
+	}
+
+	inline void window::reset_draw_profile() noexcept
+	{
+		assert( p_ );
+		p_->profiler.clear();
+	}
+
+	inline std::vector< widget_cost > window::top_widgets(std::size_t n) const
+	{
+		assert( p_ );
+		return p_->profiler.top( n );
+	}
+
+	inline std::vector< widget_type_cost > window::widget_type_costs() const
+	{
+		assert( p_ );
+		return p_->profiler.by_type();
+	}
+
+	inline void window::dispatch_input(input_record const& r)
+	{
+		assert( p_ );
+		p_->dispatch_input( r );
+	}
+
+	inline void window::start_input_recording()
+	{
+		assert( p_ );
+		p_->recording.emplace();
+		p_->recording_origin = p_->elapsed_us();
+	}
+
+	inline input_recording window::stop_input_recording()
+	{
+		assert( p_ );
+		if( !p_->recording ) {
+			return {};
+		}
+		auto rec = std::move( *p_->recording );
+		p_->recording.reset();
+		return rec;
+	}
+
+	inline bool window::is_recording_input() const noexcept
+	{
+		assert( p_ );
+		return p_->recording.has_value();
+	}
+
+	inline void window::replay_input(input_recording recording, replay_speed speed)
+	{
+		assert( p_ );
+		p_->replay = detail::input_replay{ std::move( recording ), speed, 0, p_->elapsed_us() };
+		request_idle_frame();
+	}
+
+	inline void window::stop_input_replay() noexcept
+	{
+		assert( p_ );
+		p_->replay.reset();
+	}
+
+	inline bool window::is_replaying_input() const noexcept
+	{
+		assert( p_ );
+		return p_->replay.has_value();
+	}
+
+	inline void window::render_to(spirea::d2d1::render_target const& rt)
+	{
+		assert( p_ );
+		p_->render_to( *this, rt );
+	}
+
+	inline invalidation_counters window::take_invalidations() noexcept
+	{
+		assert( p_ );
+		return std::exchange( p_->invalidations, invalidation_counters{} );
+	}
+
+	inline bitmap window::render_to_bitmap()
+	{
+		assert( p_ );
+		return p_->snapshot( *this, client_area_size(), [](detail::offscreen_target const& t) {
+			return t.to_bitmap();
+		} );
+	}
+
+	inline void window::render_to_bitmap(bitmap_view const& dst)
+	{
+		assert( p_ );
+		p_->snapshot( *this, client_area_size(), [&dst](detail::offscreen_target const& t) {
+			t.copy_to( dst );
+		} );
+	}
+
+	inline bool window::is_offscreen() const noexcept
+	{
+		assert( p_ );
+		return p_->offscreen != nullptr;
+	}
+
+	inline std::uint64_t window::target_generation() const noexcept
+	{
+		assert( p_ );
+		return p_->target_generation;
+	}
+
+	inline render_target_scope::render_target_scope(window& wnd, spirea::d2d1::render_target const& rt) noexcept :
+		p_{ wnd.p_ },
+		prev_{ p_->target }
+	{
+		p_->target = rt;
+	}
+
+	inline render_target_scope::~render_target_scope() noexcept
+	{
+		p_->target = prev_;
+	}
+
+	template <typename F>
+	inline invalidation_scope::invalidation_scope(window& wnd, F&& f, spirea::point_t< float > const& origin) :
+		p_{ wnd.p_ },
+		prev_{ p_->redraw_scope },
+		f_{ std::forward< F >( f ) },
+		origin_{ origin }
+	{
+		p_->redraw_scope = this;
+	}
+
+	inline invalidation_scope::~invalidation_scope() noexcept
+	{
+		p_->redraw_scope = prev_;
 	}
 
 	template <typename T>
 	inline void window::attach_widget(widget< T >& w)
 	{
 		assert( p_ );
-		w.set_window( p_, connect_events( p_->to_widget_handler, w ) );
+		w.set_window( p_, p_->arena, connect_events( p_->to_widget_handler, w ) );
 
-		if constexpr( has_on_event< widget< T >, event::attached >::value ) {
-			w->on_event( event::attached{}, *this );
+		if constexpr( has_on_event< widget< T >, event::detail::draw_static, void (window&) >::value ) {
+			p_->bg_layer_dirty = true;
 		}
-		if constexpr( has_on_event< widget< T >, event::recreated_target >::value ) {
-			w->on_event( event::recreated_target{}, *this );
+
+		if constexpr( has_on_event< widget< T >, event::attached, void (window&) >::value ) {
+			w->on_event( event::attached{}, *this );
 		}
 	}
 
+	inline void window::set_arena(std::shared_ptr< widget_arena > arena) noexcept
+	{
+		assert( p_ );
+		p_->arena = std::move( arena );
+	}
+
+	inline std::shared_ptr< widget_arena > const& window::arena() const noexcept
+	{
+		assert( p_ );
+		return p_->arena;
+	}
+
 	template <typename Event, typename F>
 	inline spirea::connection window::connect(Event, F&& f)
 	{
 		assert( p_ );
-		return p_->window_events_handler.connect( Event{}, std::forward< F >( f ) );
+		return p_->events_handler.connect( Event{}, std::forward< F >( f ) );
+	}
+
+	template <typename F>
+	inline bool window::post(F&& f) const
+	{
+		assert( p_ );
+
+		std::function< void (window&) > task;
+		if constexpr( std::is_invocable_v< F, window& > ) {
+			task = std::forward< F >( f );
+		}
+		else {
+			task = [f = std::forward< F >( f )](window&) mutable { f(); };
+		}
+
+		if( !p_->tasks.try_push( std::move( task ) ) ) {
+			return false;
+		}
+		if( p_->pending_tasks.fetch_add( 1, std::memory_order_acq_rel ) == 0 ) {
+			p_->wake();
+		}
+		return true;
+	}
+
+	inline void window::set_task_budget(std::chrono::microseconds budget) noexcept
+	{
+		assert( p_ );
+		p_->task_budget = budget;
+	}
+
+namespace detail {
+
+	template <typename Widget, typename Object, typename F>
+	inline void profile_widget(Widget& w, Object& obj, bool draw, F&& f)
+	{
+		auto& prof = obj.p_->profiler;
+		if( !prof.is_enabled() ) {
+			f();
+			return;
+		}
+
+		spirea::rect_t< float > bounds = {};
+		if constexpr( has_widget_size< typename Widget::type >::value ) {
+			bounds = spirea::rect_traits< spirea::rect_t< float > >::construct( w->size() );
+			auto const origin = obj.p_->scope_origin();
+			bounds.left += origin.x;
+			bounds.right += origin.x;
+			bounds.top += origin.y;
+			bounds.bottom += origin.y;
+		}
+
+		auto& cost = prof.entry(
+			static_cast< void const* >( w.operator->() ), std::weak_ptr< void const >{ w.weak() },
+			type_name< typename Widget::type >(), bounds
+		);
+		draw_profiler::scope scope{ cost, draw };
+		f();
+	}
+
+	inline void dispatch_timers()
+	{
+		std::vector< std::shared_ptr< window_context > > windows;
+		for( auto const& wp : window_registry() ) {
+			if( auto wc = wp.lock(); wc && wc->timers.size() > 0 ) {
+				windows.push_back( std::move( wc ) );
+			}
+		}
+
+		for( auto const& wc : windows ) {
+			wc->run_timers();
+		}
+	}
+
+	inline DWORD next_timer_timeout() noexcept
+	{
+		std::optional< std::uint64_t > timeout;
+		for( auto const& wp : window_registry() ) {
+			auto const wc = wp.lock();
+			if( !wc ) {
+				continue;
+			}
+			if( wc->wake_failed.load( std::memory_order_acquire ) ) {
+				return 0;
+			}
+
+			auto const deadline = wc->timers.next_deadline();
+			if( !deadline ) {
+				continue;
+			}
+
+			auto const now = wc->elapsed_ms();
+			auto const t = *deadline > now ? *deadline - now : 0;
+			if( !timeout || t < *timeout ) {
+				timeout = t;
+			}
+		}
+
+		if( !timeout ) {
+			return INFINITE;
+		}
+		return static_cast< DWORD >( std::min< std::uint64_t >( *timeout, INFINITE - 1 ) );
+	}
+
+} // namespace detail
+
+	inline int event_loop()
+	{
+		MSG msg;
+		for( ;; ) {
+			while( PeekMessageW( &msg, nullptr, 0, 0, PM_REMOVE ) ) {
+				if( msg.message == WM_QUIT ) {
+					return static_cast< int >( msg.wParam );
+				}
+				TranslateMessage( &msg );
+				DispatchMessageW( &msg );
+			}
+
+			detail::retry_failed_wakes();
+			detail::dispatch_timers();
+
+			if( detail::dispatch_idle_frames() ) {
+				continue;
+			}
+
+			MsgWaitForMultipleObjectsEx( 0, nullptr, detail::next_timer_timeout(), QS_ALLINPUT, MWMO_INPUTAVAILABLE );
+		}
 	}
 
 } // namespace musket
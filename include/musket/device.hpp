@@ -27,6 +27,8 @@ namespace musket {
 
 	using cursor_position = spirea::point_t< std::int32_t >;
 
+	using virtual_key = std::uint32_t;
+
 } // namespace musket
 
 namespace spirea {
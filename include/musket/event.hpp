@@ -14,6 +14,7 @@
 #include <spirea/signal.hpp>
 #include "geometry.hpp"
 #include "device.hpp"
+#include "trace.hpp"
 
 namespace musket {
 
@@ -89,8 +90,26 @@ namespace event {
 		using type = void (Object&, mouse_button);
 	};
 
+	struct key_pressed
+	{
+		template <typename Object>
+		using type = void (Object&, virtual_key);
+	};
+
+	struct char_input
+	{
+		template <typename Object>
+		using type = void (Object&, char32_t);
+	};
+
 namespace detail {
 
+	struct draw_static
+	{
+		template <typename Object>
+		using type = void (Object&);
+	};
+
 	struct mouse_moved_distributor
 	{
 		template <typename Object>
@@ -127,7 +146,19 @@ namespace detail {
 	{ };
 
 namespace detail {
-	
+
+	template <typename Widget, typename Object>
+	void prepare_target(Widget& w, Object& obj);
+
+	template <typename Widget, typename Object, typename F>
+	void profile_widget(Widget& w, Object& obj, bool draw, F&& f);
+
+	template <typename T, typename... Rest>
+	inline T& first_arg(T& t, Rest&&...) noexcept
+	{
+		return t;
+	}
+
 	template <typename Object, typename Event, typename EventFunc = typename Event::template type< Object >, typename = void>
 	class event_handler_element_default
 	{
@@ -193,7 +224,7 @@ namespace detail {
 				auto w = Widget{ wp };
 				auto const rc = w->size();
 				if( pt.x >= rc.left && pt.x <= rc.right && pt.y >= rc.top && pt.y <= rc.bottom ) {
-					w->on_event( Event{}, args... );
+					detail::profile_widget( w, detail::first_arg( args... ), false, [&] { w->on_event( Event{}, args... ); } );
 					return false;
 				}
 				return true;
@@ -242,16 +273,16 @@ namespace detail {
 			obj->wp = wp;
 			obj->size = [wp](){ auto w = Widget{ wp }; return w->size(); };
 
-			if constexpr( has_on_event< Widget, window_event::mouse_moved >::value ) {
+			if constexpr( has_on_event< Widget, event::mouse_moved >::value ) {
 				obj->moved = [wp](Args... args, spirea::point_t< std::int32_t > const& pt){ 
-					auto w = Widget{ wp }; w->on_event( window_event::mouse_moved{}, args..., pt ); 
+					auto w = Widget{ wp }; w->on_event( event::mouse_moved{}, args..., pt ); 
 				};
 			}
-			if constexpr( has_on_event< Widget, window_event::mouse_entered >::value ) {
-				obj->entered = [wp](Args... args){ auto w = Widget{ wp }; w->on_event( window_event::mouse_entered{}, args... ); };
+			if constexpr( has_on_event< Widget, event::mouse_entered >::value ) {
+				obj->entered = [wp](Args... args){ auto w = Widget{ wp }; w->on_event( event::mouse_entered{}, args... ); };
 			}
-			if constexpr( has_on_event< Widget, window_event::mouse_leaved >::value ) {
-				obj->leaved = [wp](Args... args){ auto w = Widget{ wp }; w->on_event( window_event::mouse_leaved{}, args... ); };
+			if constexpr( has_on_event< Widget, event::mouse_leaved >::value ) {
+				obj->leaved = [wp](Args... args){ auto w = Widget{ wp }; w->on_event( event::mouse_leaved{}, args... ); };
 			}
 
 			return signal_.connect( [obj](container_type& buf) {
@@ -336,6 +367,7 @@ namespace detail {
 		template <typename Event, typename... Args>
 		auto invoke(Event, Args&&... args)
 		{
+			trace_scope scope{ "dispatch", trace_type< Event >{} };
 			return std::get< Element< Object, Event > >( table_ ).invoke( std::forward< Args >( args )... );
 		}
 
@@ -385,8 +417,19 @@ namespace detail {
 		) {
 			return eh.connect( Event{}, w );
 		}
+		else if constexpr( std::is_same_v< Event, event::draw > || std::is_same_v< Event, event::detail::draw_static > ) {
+			return eh.connect( Event{}, [w](Args... args) mutable {
+				if constexpr( has_on_event< Widget, event::recreated_target, void (window&) >::value ) {
+					detail::prepare_target( w, args... );
+				}
+				trace_scope scope{ "draw", trace_type< typename Widget::type >{} };
+				detail::profile_widget( w, args..., true, [&] { w->on_event( Event{}, args... ); } );
+			} );
+		}
 		else {
-			return eh.connect( Event{}, [w](Args... args) mutable { return w->on_event( Event{}, args... ); } );
+			return eh.connect( Event{}, [w](Args... args) mutable {
+				detail::profile_widget( w, detail::first_arg( args... ), false, [&] { w->on_event( Event{}, args... ); } );
+			} );
 		}
 	}
 
@@ -0,0 +1,332 @@
+//--------------------------------------------------------
+// musket/include/musket/input_recording.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_INPUT_RECORDING_HPP_
+#define MUSKET_INPUT_RECORDING_HPP_
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <optional>
+#include <string_view>
+#include "device.hpp"
+
+namespace musket {
+
+	enum struct input_kind : std::uint8_t
+	{
+		mouse_button_pressed,
+		mouse_button_released,
+		mouse_moved,
+		mouse_leaved,
+		key_pressed,
+		char_input,
+	};
+
+	enum struct replay_speed
+	{
+		real_time,
+		as_fast_as_possible,
+	};
+
+	struct input_record
+	{
+		std::uint64_t time_us = 0;
+		input_kind kind = input_kind::mouse_moved;
+		mouse_button button = mouse_button::none;
+		mouse_button buttons = mouse_button::none;
+		cursor_position position = { 0, 0 };
+		std::uint32_t code = 0;
+	};
+
+namespace detail {
+
+	inline constexpr char input_recording_magic[4] = { 'M', 'S', 'K', 'I' };
+	inline constexpr std::uint8_t input_recording_version = 1;
+
+	class input_writer
+	{
+		std::vector< std::uint8_t >& buf_;
+
+	public:
+		explicit input_writer(std::vector< std::uint8_t >& buf) noexcept :
+			buf_{ buf }
+		{ }
+
+		void byte(std::uint8_t v)
+		{
+			buf_.push_back( v );
+		}
+
+		void varint(std::uint64_t v)
+		{
+			while( v >= 0x80 ) {
+				buf_.push_back( static_cast< std::uint8_t >( v | 0x80 ) );
+				v >>= 7;
+			}
+			buf_.push_back( static_cast< std::uint8_t >( v ) );
+		}
+
+		void zigzag(std::int64_t v)
+		{
+			varint( ( static_cast< std::uint64_t >( v ) << 1 ) ^ static_cast< std::uint64_t >( v >> 63 ) );
+		}
+	};
+
+	class input_reader
+	{
+		std::uint8_t const* p_;
+		std::uint8_t const* end_;
+
+	public:
+		input_reader(std::uint8_t const* p, std::size_t n) noexcept :
+			p_{ p },
+			end_{ p + n }
+		{ }
+
+		bool empty() const noexcept
+		{
+			return p_ == end_;
+		}
+
+		std::optional< std::uint8_t > byte() noexcept
+		{
+			if( p_ == end_ ) {
+				return std::nullopt;
+			}
+			return *p_++;
+		}
+
+		std::optional< std::uint64_t > varint() noexcept
+		{
+			std::uint64_t v = 0;
+			for( unsigned int shift = 0; shift < 64; shift += 7 ) {
+				if( p_ == end_ ) {
+					return std::nullopt;
+				}
+				auto const b = *p_++;
+				v |= static_cast< std::uint64_t >( b & 0x7f ) << shift;
+				if( !( b & 0x80 ) ) {
+					return v;
+				}
+			}
+			return std::nullopt;
+		}
+
+		std::optional< std::int64_t > zigzag() noexcept
+		{
+			auto const v = varint();
+			if( !v ) {
+				return std::nullopt;
+			}
+			return static_cast< std::int64_t >( *v >> 1 ) ^ -static_cast< std::int64_t >( *v & 1 );
+		}
+	};
+
+} // namespace detail
+
+	class input_recording
+	{
+		std::vector< input_record > records_;
+
+	public:
+		input_recording() = default;
+
+		void push_back(input_record const& r)
+		{
+			records_.push_back( r );
+		}
+
+		void clear() noexcept
+		{
+			records_.clear();
+		}
+
+		std::vector< input_record > const& records() const noexcept
+		{
+			return records_;
+		}
+
+		std::size_t size() const noexcept
+		{
+			return records_.size();
+		}
+
+		bool empty() const noexcept
+		{
+			return records_.empty();
+		}
+
+		std::uint64_t duration_us() const noexcept
+		{
+			return records_.empty() ? 0 : records_.back().time_us;
+		}
+
+		std::vector< std::uint8_t > encode() const
+		{
+			std::vector< std::uint8_t > buf;
+			buf.reserve( 8 + records_.size() * 6 );
+			buf.insert( buf.end(), std::begin( detail::input_recording_magic ), std::end( detail::input_recording_magic ) );
+
+			detail::input_writer w{ buf };
+			w.byte( detail::input_recording_version );
+			w.varint( records_.size() );
+
+			std::uint64_t time = 0;
+			cursor_position pos = { 0, 0 };
+			for( auto const& r : records_ ) {
+				w.varint( r.time_us - time );
+				w.byte( static_cast< std::uint8_t >( r.kind ) );
+				time = r.time_us;
+
+				switch( r.kind ) {
+				case input_kind::mouse_button_pressed:
+				case input_kind::mouse_button_released:
+					w.byte( static_cast< std::uint8_t >( r.button ) );
+					[[fallthrough]];
+				case input_kind::mouse_moved:
+					w.byte( static_cast< std::uint8_t >( r.buttons ) );
+					w.zigzag( static_cast< std::int64_t >( r.position.x ) - pos.x );
+					w.zigzag( static_cast< std::int64_t >( r.position.y ) - pos.y );
+					pos = r.position;
+					break;
+				case input_kind::mouse_leaved:
+					w.byte( static_cast< std::uint8_t >( r.buttons ) );
+					break;
+				case input_kind::key_pressed:
+				case input_kind::char_input:
+					w.varint( r.code );
+					break;
+				}
+			}
+
+			return buf;
+		}
+
+		static std::optional< input_recording > decode(std::uint8_t const* data, std::size_t size)
+		{
+			constexpr auto magic_size = sizeof( detail::input_recording_magic );
+			if( size < magic_size || !std::equal( data, data + magic_size, std::begin( detail::input_recording_magic ) ) ) {
+				return std::nullopt;
+			}
+
+			detail::input_reader r{ data + magic_size, size - magic_size };
+			if( r.byte() != detail::input_recording_version ) {
+				return std::nullopt;
+			}
+			auto const n = r.varint();
+			if( !n ) {
+				return std::nullopt;
+			}
+
+			input_recording rec;
+			rec.records_.reserve( static_cast< std::size_t >( std::min< std::uint64_t >( *n, size ) ) );
+
+			std::uint64_t time = 0;
+			cursor_position pos = { 0, 0 };
+			for( std::uint64_t i = 0; i < *n; ++i ) {
+				auto const dt = r.varint();
+				auto const kind = r.byte();
+				if( !dt || !kind || *kind > static_cast< std::uint8_t >( input_kind::char_input ) ) {
+					return std::nullopt;
+				}
+
+				input_record ir;
+				time += *dt;
+				ir.time_us = time;
+				ir.kind = static_cast< input_kind >( *kind );
+
+				switch( ir.kind ) {
+				case input_kind::mouse_button_pressed:
+				case input_kind::mouse_button_released:
+				case input_kind::mouse_moved: {
+					if( ir.kind != input_kind::mouse_moved ) {
+						auto const btn = r.byte();
+						if( !btn ) {
+							return std::nullopt;
+						}
+						ir.button = static_cast< mouse_button >( *btn );
+					}
+					auto const btns = r.byte();
+					auto const dx = r.zigzag();
+					auto const dy = r.zigzag();
+					if( !btns || !dx || !dy ) {
+						return std::nullopt;
+					}
+					ir.buttons = static_cast< mouse_button >( *btns );
+					pos.x += static_cast< std::int32_t >( *dx );
+					pos.y += static_cast< std::int32_t >( *dy );
+					ir.position = pos;
+					break;
+				}
+				case input_kind::mouse_leaved: {
+					auto const btns = r.byte();
+					if( !btns ) {
+						return std::nullopt;
+					}
+					ir.buttons = static_cast< mouse_button >( *btns );
+					break;
+				}
+				case input_kind::key_pressed:
+				case input_kind::char_input: {
+					auto const code = r.varint();
+					if( !code ) {
+						return std::nullopt;
+					}
+					ir.code = static_cast< std::uint32_t >( *code );
+					break;
+				}
+				}
+
+				rec.records_.push_back( ir );
+			}
+
+			return rec;
+		}
+
+		bool save(std::string_view path) const
+		{
+			std::ofstream ofs{ std::string{ path.begin(), path.end() }, std::ios::binary };
+			if( !ofs ) {
+				return false;
+			}
+			auto const buf = encode();
+			ofs.write( reinterpret_cast< char const* >( buf.data() ), static_cast< std::streamsize >( buf.size() ) );
+			return static_cast< bool >( ofs );
+		}
+
+		static std::optional< input_recording > load(std::string_view path)
+		{
+			std::ifstream ifs{ std::string{ path.begin(), path.end() }, std::ios::binary };
+			if( !ifs ) {
+				return std::nullopt;
+			}
+			std::vector< std::uint8_t > const buf{ std::istreambuf_iterator< char >{ ifs }, std::istreambuf_iterator< char >{} };
+			return decode( buf.data(), buf.size() );
+		}
+	};
+
+namespace detail {
+
+	struct input_replay
+	{
+		input_recording recording;
+		replay_speed speed;
+		std::size_t next = 0;
+		std::uint64_t origin = 0;
+	};
+
+} // namespace detail
+
+} // namespace musket
+
+#endif // MUSKET_INPUT_RECORDING_HPP_
\ No newline at end of file
@@ -0,0 +1,324 @@
+//--------------------------------------------------------
+// musket/include/musket/stats.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_STATS_HPP_
+#define MUSKET_STATS_HPP_
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include <string_view>
+
+namespace musket {
+
+	enum struct stats_event : std::uint8_t
+	{
+		idle,
+		draw,
+		resized,
+		mouse_button_pressed,
+		mouse_button_released,
+		mouse_moved,
+		key_pressed,
+		char_input,
+		timers,
+		tasks,
+	};
+
+	constexpr std::size_t size_of_stats_events = 10;
+
+	inline std::string_view to_string(stats_event e) noexcept
+	{
+		constexpr std::string_view names[] = {
+			"idle", "draw", "resized", "mouse_button_pressed", "mouse_button_released",
+			"mouse_moved", "key_pressed", "char_input", "timers", "tasks",
+		};
+		return names[static_cast< std::size_t >( e )];
+	}
+
+	struct histogram_snapshot
+	{
+		static constexpr std::size_t size_of_buckets = 20;
+
+		std::size_t count = 0;
+		double min = 0.0;
+		double max = 0.0;
+		double mean = 0.0;
+		double p50 = 0.0;
+		double p95 = 0.0;
+		double p99 = 0.0;
+		std::array< std::uint32_t, size_of_buckets > buckets = {};
+	};
+
+	struct frame_stats
+	{
+		histogram_snapshot paint;
+		histogram_snapshot input_latency;
+		histogram_snapshot redraw_requests;
+		std::array< histogram_snapshot, size_of_stats_events > dispatch;
+
+		std::string to_csv() const
+		{
+			std::string s = "metric,unit,count,min,max,mean,p50,p95,p99\n";
+			auto row = [&s](std::string_view name, std::string_view unit, histogram_snapshot const& h) {
+				s.append( name ).append( "," ).append( unit );
+				s.append( "," ).append( std::to_string( h.count ) );
+				for( auto v : { h.min, h.max, h.mean, h.p50, h.p95, h.p99 } ) {
+					s.append( "," ).append( std::to_string( v ) );
+				}
+				s.append( "\n" );
+			};
+
+			row( "paint", "us", paint );
+			row( "input_latency", "us", input_latency );
+			row( "redraw_requests", "count", redraw_requests );
+			for( std::size_t i = 0; i < dispatch.size(); ++i ) {
+				row( std::string{ "dispatch." }.append( to_string( static_cast< stats_event >( i ) ) ), "us", dispatch[i] );
+			}
+			return s;
+		}
+
+		std::string to_json() const
+		{
+			auto object = [](histogram_snapshot const& h) {
+				std::string s = "{\"count\":" + std::to_string( h.count );
+				s += ",\"min\":" + std::to_string( h.min );
+				s += ",\"max\":" + std::to_string( h.max );
+				s += ",\"mean\":" + std::to_string( h.mean );
+				s += ",\"p50\":" + std::to_string( h.p50 );
+				s += ",\"p95\":" + std::to_string( h.p95 );
+				s += ",\"p99\":" + std::to_string( h.p99 );
+				s += ",\"buckets\":[";
+				for( std::size_t i = 0; i < h.buckets.size(); ++i ) {
+					s += ( i > 0 ? "," : "" ) + std::to_string( h.buckets[i] );
+				}
+				return s + "]}";
+			};
+
+			std::string s = "{\"paint_us\":" + object( paint );
+			s += ",\"input_latency_us\":" + object( input_latency );
+			s += ",\"redraw_requests\":" + object( redraw_requests );
+			s += ",\"dispatch_us\":{";
+			for( std::size_t i = 0; i < dispatch.size(); ++i ) {
+				s += i > 0 ? "," : "";
+				s.append( "\"" ).append( to_string( static_cast< stats_event >( i ) ) ).append( "\":" );
+				s += object( dispatch[i] );
+			}
+			return s + "}}";
+		}
+	};
+
+namespace detail {
+
+#ifdef MUSKET_ENABLE_STATS
+	inline constexpr bool stats_enabled = true;
+#else
+	inline constexpr bool stats_enabled = false;
+#endif
+
+	class rolling_histogram
+	{
+		static constexpr std::size_t capacity = 1024;
+
+		std::array< std::uint32_t, capacity > samples_ = {};
+		std::size_t next_ = 0;
+		std::size_t size_ = 0;
+
+	public:
+		void record(std::uint32_t v) noexcept
+		{
+			samples_[next_] = v;
+			next_ = ( next_ + 1 ) % capacity;
+			size_ = std::min( size_ + 1, capacity );
+		}
+
+		histogram_snapshot snapshot() const
+		{
+			histogram_snapshot h;
+			if( size_ == 0 ) {
+				return h;
+			}
+
+			std::vector< std::uint32_t > sorted( samples_.begin(), samples_.begin() + size_ );
+			std::sort( sorted.begin(), sorted.end() );
+
+			double sum = 0.0;
+			for( auto v : sorted ) {
+				sum += v;
+				std::size_t b = 0;
+				while( b + 1 < h.buckets.size() && ( std::uint64_t{ 1 } << ( b + 1 ) ) <= v ) {
+					++b;
+				}
+				++h.buckets[b];
+			}
+
+			auto const percentile = [&sorted](double p) {
+				return static_cast< double >( sorted[static_cast< std::size_t >( p * ( sorted.size() - 1 ) )] );
+			};
+
+			h.count = sorted.size();
+			h.min = sorted.front();
+			h.max = sorted.back();
+			h.mean = sum / static_cast< double >( sorted.size() );
+			h.p50 = percentile( 0.50 );
+			h.p95 = percentile( 0.95 );
+			h.p99 = percentile( 0.99 );
+			return h;
+		}
+	};
+
+	template <bool Enabled>
+	class window_stats_t;
+
+	template <>
+	class window_stats_t< true >
+	{
+		using clock = std::chrono::steady_clock;
+
+		rolling_histogram paint_;
+		rolling_histogram latency_;
+		rolling_histogram redraws_;
+		std::array< rolling_histogram, size_of_stats_events > dispatch_;
+		std::optional< clock::time_point > input_;
+		std::optional< clock::time_point > pending_input_;
+		std::uint32_t pending_requests_ = 0;
+		std::uint32_t redraw_requests_ = 0;
+
+		static std::uint32_t microseconds(clock::duration d) noexcept
+		{
+			auto const us = std::chrono::duration_cast< std::chrono::microseconds >( d ).count();
+			return static_cast< std::uint32_t >( std::clamp< decltype( us ) >( us, 0, UINT32_MAX ) );
+		}
+
+	public:
+		using time_point = clock::time_point;
+
+		static time_point now() noexcept
+		{
+			return clock::now();
+		}
+
+		void input_arrived(time_point t) noexcept
+		{
+			pending_input_ = t;
+			pending_requests_ = redraw_requests_;
+		}
+
+		void input_handled() noexcept
+		{
+			if( !pending_input_ ) {
+				return;
+			}
+			if( !input_ && redraw_requests_ != pending_requests_ ) {
+				input_ = pending_input_;
+			}
+			pending_input_.reset();
+		}
+
+		void redraw_requested() noexcept
+		{
+			++redraw_requests_;
+		}
+
+		void dispatched(stats_event e, time_point start) noexcept
+		{
+			dispatch_[static_cast< std::size_t >( e )].record( microseconds( now() - start ) );
+		}
+
+		void painted(time_point start) noexcept
+		{
+			auto const end = now();
+			paint_.record( microseconds( end - start ) );
+			if( input_ ) {
+				latency_.record( microseconds( end - *input_ ) );
+				input_.reset();
+			}
+			redraws_.record( redraw_requests_ );
+			redraw_requests_ = 0;
+		}
+
+		frame_stats snapshot() const
+		{
+			frame_stats s;
+			s.paint = paint_.snapshot();
+			s.input_latency = latency_.snapshot();
+			s.redraw_requests = redraws_.snapshot();
+			for( std::size_t i = 0; i < dispatch_.size(); ++i ) {
+				s.dispatch[i] = dispatch_[i].snapshot();
+			}
+			return s;
+		}
+	};
+
+	template <>
+	class window_stats_t< false >
+	{
+	public:
+		struct time_point
+		{ };
+
+		static constexpr time_point now() noexcept
+		{
+			return {};
+		}
+
+		void input_arrived(time_point) noexcept
+		{ }
+
+		void input_handled() noexcept
+		{ }
+
+		void redraw_requested() noexcept
+		{ }
+
+		void dispatched(stats_event, time_point) noexcept
+		{ }
+
+		void painted(time_point) noexcept
+		{ }
+
+		frame_stats snapshot() const
+		{
+			return {};
+		}
+	};
+
+	using window_stats = window_stats_t< stats_enabled >;
+
+	class stats_scope
+	{
+		window_stats& stats_;
+		stats_event event_;
+		window_stats::time_point start_;
+
+	public:
+		stats_scope(window_stats& stats, stats_event e) noexcept :
+			stats_{ stats },
+			event_{ e },
+			start_{ window_stats::now() }
+		{ }
+
+		~stats_scope() noexcept
+		{
+			stats_.dispatched( event_, start_ );
+		}
+
+		stats_scope(stats_scope const&) = delete;
+		stats_scope& operator=(stats_scope const&) = delete;
+	};
+
+} // namespace detail
+
+} // namespace musket
+
+#endif // MUSKET_STATS_HPP_
\ No newline at end of file
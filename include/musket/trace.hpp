@@ -0,0 +1,296 @@
+//--------------------------------------------------------
+// musket/include/musket/trace.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_TRACE_HPP_
+#define MUSKET_TRACE_HPP_
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <typeinfo>
+#include <string_view>
+
+namespace musket {
+
+	template <typename T>
+	struct trace_type
+	{ };
+
+namespace detail {
+
+#ifdef MUSKET_ENABLE_TRACE
+	inline constexpr bool trace_enabled = true;
+#else
+	inline constexpr bool trace_enabled = false;
+#endif
+
+	inline std::atomic< bool > trace_active{ false };
+
+	struct trace_record
+	{
+		char const* category;
+		char const* name;
+		std::int64_t begin;
+		std::int64_t duration;
+	};
+
+	class trace_buffer
+	{
+	public:
+		static constexpr std::size_t capacity = std::size_t{ 1 } << 16;
+
+	private:
+		struct slot
+		{
+			std::atomic< std::uint64_t > seq{ 0 };
+			std::atomic< char const* > category{ nullptr };
+			std::atomic< char const* > name{ nullptr };
+			std::atomic< std::int64_t > begin{ 0 };
+			std::atomic< std::int64_t > duration{ 0 };
+		};
+
+		std::unique_ptr< slot[] > slots_{ new slot[capacity] };
+		std::atomic< std::uint64_t > head_{ 0 };
+		std::uint32_t tid_;
+
+	public:
+		explicit trace_buffer(std::uint32_t tid) noexcept :
+			tid_{ tid }
+		{ }
+
+		std::uint32_t tid() const noexcept
+		{
+			return tid_;
+		}
+
+		void push(trace_record const& r) noexcept
+		{
+			auto const h = head_.load( std::memory_order_relaxed );
+			auto& s = slots_[h % capacity];
+			s.seq.store( h * 2 + 1, std::memory_order_relaxed );
+			std::atomic_thread_fence( std::memory_order_release );
+			s.category.store( r.category, std::memory_order_relaxed );
+			s.name.store( r.name, std::memory_order_relaxed );
+			s.begin.store( r.begin, std::memory_order_relaxed );
+			s.duration.store( r.duration, std::memory_order_relaxed );
+			s.seq.store( h * 2 + 2, std::memory_order_release );
+			head_.store( h + 1, std::memory_order_release );
+		}
+
+		template <typename F>
+		void for_each(F&& f) const
+		{
+			auto const h = head_.load( std::memory_order_acquire );
+			for( auto i = h > capacity ? h - capacity : 0; i < h; ++i ) {
+				auto const& s = slots_[i % capacity];
+				auto const seq = i * 2 + 2;
+				if( s.seq.load( std::memory_order_acquire ) != seq ) {
+					continue;
+				}
+
+				trace_record const r = {
+					s.category.load( std::memory_order_relaxed ),
+					s.name.load( std::memory_order_relaxed ),
+					s.begin.load( std::memory_order_relaxed ),
+					s.duration.load( std::memory_order_relaxed ),
+				};
+				std::atomic_thread_fence( std::memory_order_acquire );
+				if( s.seq.load( std::memory_order_relaxed ) != seq ) {
+					continue;
+				}
+
+				f( r );
+			}
+		}
+
+		void clear() noexcept
+		{
+			head_.store( 0, std::memory_order_release );
+		}
+	};
+
+	class trace_registry
+	{
+		std::mutex mtx_;
+		std::vector< std::shared_ptr< trace_buffer > > buffers_;
+		std::chrono::steady_clock::time_point origin_ = std::chrono::steady_clock::now();
+
+	public:
+		static trace_registry& instance()
+		{
+			static trace_registry reg;
+			return reg;
+		}
+
+		std::int64_t now() const noexcept
+		{
+			return std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - origin_ ).count();
+		}
+
+		trace_buffer& local()
+		{
+			thread_local std::shared_ptr< trace_buffer > buf = [this] {
+				std::lock_guard lock{ mtx_ };
+				auto p = std::make_shared< trace_buffer >( static_cast< std::uint32_t >( buffers_.size() + 1 ) );
+				buffers_.push_back( p );
+				return p;
+			}();
+			return *buf;
+		}
+
+		template <typename F>
+		void for_each(F&& f)
+		{
+			std::lock_guard lock{ mtx_ };
+			for( auto const& b : buffers_ ) {
+				b->for_each( [&](trace_record const& r) { f( b->tid(), r ); } );
+			}
+		}
+
+		void clear()
+		{
+			std::lock_guard lock{ mtx_ };
+			for( auto const& b : buffers_ ) {
+				b->clear();
+			}
+		}
+	};
+
+	template <typename T>
+	inline char const* type_name() noexcept
+	{
+		static char const* const name = typeid( T ).name();
+		return name;
+	}
+
+	inline void append_json_string(std::string& s, char const* str)
+	{
+		s += '"';
+		for( auto p = str; *p; ++p ) {
+			if( *p == '"' || *p == '\\' ) {
+				s += '\\';
+			}
+			s += *p;
+		}
+		s += '"';
+	}
+
+} // namespace detail
+
+#ifdef MUSKET_ENABLE_TRACE
+	class trace_scope
+	{
+		char const* category_;
+		char const* name_ = nullptr;
+		std::int64_t begin_ = 0;
+
+	public:
+		trace_scope(char const* category, char const* name) noexcept :
+			category_{ category }
+		{
+			if( detail::trace_active.load( std::memory_order_relaxed ) ) {
+				name_ = name;
+				begin_ = detail::trace_registry::instance().now();
+			}
+		}
+
+		template <typename T>
+		trace_scope(char const* category, trace_type< T >) noexcept :
+			category_{ category }
+		{
+			if( detail::trace_active.load( std::memory_order_relaxed ) ) {
+				name_ = detail::type_name< T >();
+				begin_ = detail::trace_registry::instance().now();
+			}
+		}
+
+		~trace_scope() noexcept
+		{
+			if( name_ ) {
+				auto& reg = detail::trace_registry::instance();
+				reg.local().push( { category_, name_, begin_, reg.now() - begin_ } );
+			}
+		}
+
+		trace_scope(trace_scope const&) = delete;
+		trace_scope& operator=(trace_scope const&) = delete;
+	};
+#else
+	class trace_scope
+	{
+	public:
+		constexpr trace_scope(char const*, char const*) noexcept
+		{ }
+
+		template <typename T>
+		constexpr trace_scope(char const*, trace_type< T >) noexcept
+		{ }
+
+		trace_scope(trace_scope const&) = delete;
+		trace_scope& operator=(trace_scope const&) = delete;
+	};
+#endif
+
+	inline void start_tracing() noexcept
+	{
+		detail::trace_active.store( true, std::memory_order_release );
+	}
+
+	inline void stop_tracing() noexcept
+	{
+		detail::trace_active.store( false, std::memory_order_release );
+	}
+
+	inline bool is_tracing() noexcept
+	{
+		return detail::trace_enabled && detail::trace_active.load( std::memory_order_relaxed );
+	}
+
+	inline void clear_trace()
+	{
+		detail::trace_registry::instance().clear();
+	}
+
+	inline std::string trace_json()
+	{
+		std::string s = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		bool first = true;
+		detail::trace_registry::instance().for_each( [&](std::uint32_t tid, detail::trace_record const& r) {
+			s += first ? "{" : ",{";
+			first = false;
+			s += "\"name\":";
+			detail::append_json_string( s, r.name );
+			s += ",\"cat\":";
+			detail::append_json_string( s, r.category );
+			s += ",\"ph\":\"X\",\"pid\":1,\"tid\":" + std::to_string( tid );
+			s += ",\"ts\":" + std::to_string( static_cast< double >( r.begin ) / 1000.0 );
+			s += ",\"dur\":" + std::to_string( static_cast< double >( r.duration ) / 1000.0 ) + "}";
+		} );
+		return s + "]}";
+	}
+
+	inline bool write_trace(std::string_view path)
+	{
+		std::ofstream ofs{ std::string{ path.begin(), path.end() }, std::ios::binary };
+		if( !ofs ) {
+			return false;
+		}
+		auto const json = trace_json();
+		ofs.write( json.data(), static_cast< std::streamsize >( json.size() ) );
+		return static_cast< bool >( ofs );
+	}
+
+} // namespace musket
+
+#endif // MUSKET_TRACE_HPP_
\ No newline at end of file
@@ -11,12 +11,14 @@
 #define MUSKET_WIDGET_HPP_
 
 #include <memory>
+#include <cstdint>
 #include <cassert>
 #include <type_traits>
 #include "operator.hpp"
 #include "geometry.hpp"
 #include "color.hpp"
 #include "event.hpp"
+#include "arena.hpp"
 #include "window.hpp"
 
 namespace musket {
@@ -37,34 +39,77 @@ namespace detail {
 
 	struct window_context;
 
+	template <typename T, typename = void>
+	struct has_bind_window :
+		std::false_type
+	{ };
+
+	template <typename T>
+	struct has_bind_window< T, std::void_t< decltype( std::declval< T& >().bind_window( std::weak_ptr< window_context >{} ) ) > > :
+		std::true_type
+	{ };
+
 	template <typename T>
 	struct widget_object
 	{
 		struct connection_deleter
 		{
+			std::pmr::memory_resource* mr = nullptr;
+			std::shared_ptr< widget_arena > arena;
+
 			void operator()(event_connections< window_events >* p) const noexcept
 			{
 				p->disconnect_all();
-				delete p;
+				arena_delete( mr, p );
 			}
 		};
 
-		std::unique_ptr< T > handle;
+		using handle_type = std::unique_ptr< T, arena_deleter< T > >;
+		using connections_type = std::unique_ptr< event_connections< window_events >, connection_deleter >;
+
+		handle_type handle;
 		std::weak_ptr< detail::window_context > wnd;
-		std::unique_ptr< event_connections< window_events >, connection_deleter > conns;
+		connections_type conns;
+		std::uint64_t target_generation = 0;
+		std::pmr::memory_resource* resource = nullptr;
 
-		void attach(std::shared_ptr< detail::window_context >& w, event_connections< window_events >&& c)
+		void attach(std::shared_ptr< detail::window_context >& w, std::shared_ptr< widget_arena > const& arena, event_connections< window_events >&& c)
 		{
 			wnd = w;
-			conns.reset( new event_connections< window_events >{ std::move( c ) } );
+			if constexpr( has_bind_window< T >::value ) {
+				handle->bind_window( wnd );
+			}
+
+			auto const mr = arena ? arena->resource() : resource;
+			if( conns && conns.get_deleter().mr == mr ) {
+				conns->disconnect_all();
+				*conns = std::move( c );
+				return;
+			}
+			conns = connections_type{
+				arena_new< event_connections< window_events > >( mr, std::move( c ) ),
+				connection_deleter{ mr, arena }
+			};
 		}
 
 		void detach()
 		{
+			if( auto const w = wnd.lock() ) {
+				forget_widget( w, handle.get() );
+				if constexpr( has_on_event< T*, event::detail::draw_static, void (window&) >::value ) {
+					invalidate_background_layer( w );
+				}
+			}
+
 			wnd.reset();
-			conns.reset();
+			if( conns ) {
+				conns->disconnect_all();
+			}
+			if constexpr( has_bind_window< T >::value ) {
+				handle->bind_window( {} );
+			}
 
-			if constexpr( has_on_event< T, widget_event::detached >::value ) {
+			if constexpr( has_on_event< T*, widget_event::detached, void () >::value ) {
 				handle->on_event( widget_event::detached{} );
 			}
 		}
@@ -88,13 +133,28 @@ namespace detail {
 
 		template <
 			typename Arg, typename... Args, 
-			std::enable_if_t< !std::is_same_v< Arg, std::weak_ptr< detail::widget_object< T > > >, std::nullptr_t > = nullptr
+			std::enable_if_t<
+				!std::is_same_v< Arg, std::weak_ptr< detail::widget_object< T > > >
+				&& !std::is_same_v< std::decay_t< Arg >, std::allocator_arg_t >,
+				std::nullptr_t
+			> = nullptr
 		>
 		widget(Arg&& arg, Args&&... args) :
-			p_{ new detail::widget_object< T >{
-				std::unique_ptr< T >{ new T{ std::forward< Arg >( arg ), std::forward< Args >( args )... } },
-				{}, {}
-			} }
+			widget{ std::allocator_arg, detail::current_arena(), std::forward< Arg >( arg ), std::forward< Args >( args )... }
+		{ }
+
+		template <typename... Args>
+		widget(std::allocator_arg_t, std::pmr::memory_resource* mr, Args&&... args) :
+			p_{
+				detail::arena_new< detail::widget_object< T > >( mr, detail::widget_object< T >{
+					typename detail::widget_object< T >::handle_type{
+						detail::arena_new< T >( mr, std::forward< Args >( args )... ),
+						detail::arena_deleter< T >{ mr }
+					},
+					{}, {}, 0, mr
+				} ),
+				detail::arena_deleter< detail::widget_object< T > >{ mr }
+			}
 		{ }
 
 		explicit widget(std::weak_ptr< detail::widget_object< T > > const& wp) :
@@ -138,15 +198,57 @@ namespace detail {
 			return { p_ };
 		}
 
+		std::pmr::memory_resource* resource() const noexcept
+		{
+			return p_ ? p_->resource : nullptr;
+		}
+
 	private:
-		void set_window(std::shared_ptr< detail::window_context >& wnd, event_connections< window_events >&& conns)
+		void set_window(std::shared_ptr< detail::window_context >& wnd, std::shared_ptr< widget_arena > const& arena, event_connections< window_events >&& conns)
 		{
-			p_->attach( wnd, std::move( conns ) );
+			p_->attach( wnd, arena, std::move( conns ) );
 		}
 
 		friend class window;
+
+		template <typename Widget, typename Object>
+		friend void detail::prepare_target(Widget& w, Object& obj);
 	};
 
+namespace detail {
+
+	template <typename T, typename = void>
+	struct has_is_visible :
+		std::false_type
+	{ };
+
+	template <typename T>
+	struct has_is_visible< T, std::void_t< decltype( std::declval< T const& >().is_visible() ) > > :
+		std::true_type
+	{ };
+
+	template <typename Widget, typename Object>
+	inline void prepare_target(Widget& w, Object& obj)
+	{
+		auto& p = *w.p_;
+		auto const generation = obj.target_generation();
+		if( p.target_generation == generation ) {
+			return;
+		}
+
+		if constexpr( has_is_visible< typename Widget::type >::value ) {
+			if( !p.handle->is_visible() ) {
+				return;
+			}
+		}
+
+		trace_scope scope{ "resource", trace_type< typename Widget::type >{} };
+		p.handle->on_event( event::recreated_target{}, obj );
+		p.target_generation = generation;
+	}
+
+} // namespace detail
+
 	template <typename T>
 	inline bool is_attached(widget< T > const& w) noexcept
 	{
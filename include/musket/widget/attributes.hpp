@@ -93,6 +93,50 @@ namespace event {
 		}
 	};
 
+	template <typename Widget>
+	class static_layer :
+		public Widget
+	{
+		std::weak_ptr< detail::window_context > layer_wnd_;
+
+	public:
+		using Widget::Widget;
+		using Widget::on_event;
+
+		void show() noexcept
+		{
+			Widget::show();
+			redraw_layer();
+		}
+
+		void hide() noexcept
+		{
+			Widget::hide();
+			redraw_layer();
+		}
+
+		void bind_window(std::weak_ptr< detail::window_context > const& wnd) noexcept
+		{
+			Widget::bind_window( wnd );
+			layer_wnd_ = wnd;
+		}
+
+		void on_event(event::draw, window&) = delete;
+
+		void on_event(event::detail::draw_static, window& wnd)
+		{
+			Widget::on_event( event::draw{}, wnd );
+		}
+
+	private:
+		void redraw_layer() noexcept
+		{
+			if( auto const p = layer_wnd_.lock() ) {
+				detail::invalidate_background_layer( p );
+			}
+		}
+	};
+
 } // namespace musket
 
 #endif // MUSKET_WIDGET_ATTRIBUTES_HPP_
\ No newline at end of file
@@ -12,6 +12,9 @@
 
 #include "facade.hpp"
 #include "attributes.hpp"
+#include "prepared_text.hpp"
+#include "transition.hpp"
+#include "shared_style.hpp"
 
 namespace musket {
 
@@ -19,9 +22,9 @@ namespace musket {
 
 	struct button_style
 	{
-		std::optional< rgba_color_t > bg_color;
+		std::optional< rgba8 > bg_color;
 		std::optional< edge_property > edge;
-		std::optional< rgba_color_t > text_color;
+		std::optional< rgba8 > text_color;
 	};
 
 	enum struct button_state : std::uint8_t
@@ -93,6 +96,7 @@ namespace musket {
 		std::optional< button_style > idle_style = {};
 		std::optional< button_style > over_style = {};
 		std::optional< button_style > pressed_style = {};
+		std::chrono::milliseconds transition = default_transition_duration;
 	};
 
 namespace button_event {
@@ -119,7 +123,7 @@ namespace button_event {
 	class button :
 		public widget_facade
 	{
-		using style_data_type = style_data_t< button_style >;
+		using style_data_type = shared_style< button_style >;
 
 		using state_machine_type = state_machine< 
 			style_data_type, button_state, 
@@ -128,6 +132,7 @@ namespace button_event {
 
 		std::string str_;
 		state_machine_type states_;
+		style_transition< button_style > transition_;
 		spirea::dwrite::text_layout text_;
 		event_handler< button, button_events > event_handler_;
 
@@ -137,9 +142,18 @@ namespace button_event {
 			Rect const& rc,
 			std::string_view str, 
 			button_property const& prop = {}
+		) :
+			button{ rc, prepare_text( request_text( rc, str, prop ) ), prop }
+		{ }
+
+		template <typename Rect>
+		button(
+			Rect const& rc,
+			prepared_text text, 
+			button_property const& prop = {}
 		) :
 			widget_facade{ rc },
-			str_{ str.begin(), str.end() },
+			str_{ std::move( text.str ) },
 			states_{ 
 				button_state::idle, 
 				style_data_type{ 
@@ -151,12 +165,21 @@ namespace button_event {
 				style_data_type{ 
 					deref_style< button >( prop.pressed_style, button_state::pressed )
 				} 
-			}
+			},
+			transition_{ prop.transition },
+			text_{ std::move( text.layout ) }
+		{ }
+
+		template <typename Rect>
+		static text_request request_text(Rect const& rc, std::string_view str, button_property const& prop = {})
 		{
-			spirea::dwrite::text_format format = create_text_format( deref_text_format( prop.text_fmt ) );
-			format->SetTextAlignment( spirea::dwrite::text_alignment::center );
-			format->SetParagraphAlignment( spirea::dwrite::paragraph_alignment::center );
-			text_ = create_text_layout( format, this->size(), str );
+			return {
+				deref_text_format( prop.text_fmt ),
+				spirea::dwrite::text_alignment::center,
+				spirea::dwrite::paragraph_alignment::center,
+				spirea::rect_traits< spirea::rect_t< float > >::construct( rc ),
+				std::string{ str.begin(), str.end() }
+			};
 		}
 
 		template <typename Event, typename F>
@@ -173,7 +196,7 @@ namespace button_event {
 
 			auto const rc = spirea::rect_traits< spirea::d2d1::rect_f >::construct( this->size() );
 			auto const rt = wnd.render_target();
-			auto const& data = states_.get();
+			auto const& data = transition_.get( rt, *states_.get() );
 
 			data.draw_background( rt, rc );
 			data.draw_edge( rt, rc );
@@ -186,41 +209,38 @@ namespace button_event {
 			for( auto& i : states_.data() ) {
 				i.recreated_target( rt );
 			}
+			transition_.recreated_target( rt );
 		}
 
 		void on_event(event::mouse_button_pressed, window& wnd, mouse_button btn, mouse_button, spirea::point_t< std::int32_t > const& pt)
 		{
 			if( spirea::enabled( btn, mouse_button::left ) ) {
-				states_.trasition( button_state::pressed );
+				change_state( wnd, button_state::pressed );
 				event_handler_.invoke( button_event::pressed{}, pt );
-				wnd.redraw();
 			}
 		}
 
 		void on_event(event::mouse_button_released, window& wnd, mouse_button btn, mouse_button, spirea::point_t< std::int32_t > const& pt)
 		{
 			if( spirea::enabled( btn, mouse_button::left ) ) {
-				states_.trasition( button_state::idle );
+				change_state( wnd, button_state::idle );
 				event_handler_.invoke( button_event::released{}, pt );
-				wnd.redraw();
 			}
 		}
 
 		void on_event(event::mouse_entered, window& wnd, mouse_button btns)
 		{
 			if( spirea::enabled( btns, mouse_button::left ) ) {
-				states_.trasition( button_state::pressed );
+				change_state( wnd, button_state::pressed );
 			}
 			else {
-				states_.trasition( button_state::over );
+				change_state( wnd, button_state::over );
 			}
-			wnd.redraw();
 		}
 
 		void on_event(event::mouse_leaved, window& wnd, mouse_button)
 		{
-			states_.trasition( button_state::idle );
-			wnd.redraw();
+			change_state( wnd, button_state::idle );
 		}
 
 		void on_event(event::auto_resize, window& wnd, spirea::rect_t< float > const& rc)
@@ -228,6 +248,17 @@ namespace button_event {
 			text_->SetMaxWidth( rc.width() );
 			text_->SetMaxHeight( rc.height() );
 		}
+
+	private:
+		void change_state(window& wnd, button_state s)
+		{
+			if( states_.state() != s ) {
+				auto const prev = states_.get().get_style();
+				states_.trasition( s );
+				transition_.start( wnd, prev, states_.get().get_style(), size() );
+			}
+			wnd.redraw( size() );
+		}
 	};
 
 } // namespace musket	
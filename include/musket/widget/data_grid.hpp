@@ -0,0 +1,450 @@
+//--------------------------------------------------------
+// musket/include/musket/widget/data_grid.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_WIDGET_DATA_GRID_HPP_
+#define MUSKET_WIDGET_DATA_GRID_HPP_
+
+#include <cmath>
+#include <vector>
+#include <cassert>
+#include <algorithm>
+#include <functional>
+#include "facade.hpp"
+#include "../widget.hpp"
+#include "../detail/lru_cache.hpp"
+#include "scroll_bar.hpp"
+
+namespace musket {
+
+	struct data_grid_style
+	{
+		std::optional< rgba8 > bg_color;
+		std::optional< edge_property > edge;
+		std::optional< rgba8 > text_color;
+	};
+
+	enum struct data_grid_part : std::uint8_t
+	{
+		cell, header,
+	};
+
+	class data_grid;
+
+	template <>
+	class default_style_t< data_grid >
+	{
+		inline static data_grid_style cell_ = {
+			rgba_color_t{ 0.15f, 0.15f, 0.15f, 1.0f },
+			musket::edge_property{ { 0.3f, 0.3f, 0.3f, 1.0f }, 1.0f },
+			rgba_color_t{ 1.0f, 1.0f, 1.0f, 1.0f },
+		};
+
+		inline static data_grid_style header_ = {
+			rgba_color_t{ 0.25f, 0.25f, 0.25f, 1.0f },
+			musket::edge_property{ { 0.5f, 0.5f, 0.5f, 1.0f }, 1.0f },
+			rgba_color_t{ 1.0f, 1.0f, 1.0f, 1.0f },
+		};
+
+		inline static std::mutex mtx_;
+
+	public:
+		static void set(data_grid_part part, data_grid_style const& style) noexcept
+		{
+			std::lock_guard lock{ mtx_ };
+
+			switch( part ) {
+			case data_grid_part::cell:
+				cell_ = style;
+				break;
+			case data_grid_part::header:
+				header_ = style;
+				break;
+			}
+		}
+
+		static data_grid_style get(data_grid_part part) noexcept
+		{
+			std::lock_guard lock{ mtx_ };
+
+			switch( part ) {
+			case data_grid_part::cell:
+				return cell_;
+			case data_grid_part::header:
+				return header_;
+			}
+
+			return {};
+		}
+	};
+
+	struct data_grid_property
+	{
+		std::optional< text_format > text_fmt = {};
+		std::optional< data_grid_style > cell_style = {};
+		std::optional< data_grid_style > header_style = {};
+		scroll_bar_property scroll_bar = {};
+		std::vector< float > column_widths = {};
+		float default_column_width = 80.0f;
+		float row_height = 20.0f;
+		float scroll_bar_width = 16.0f;
+		std::size_t header_rows = 1;
+		std::size_t header_columns = 0;
+		std::size_t cache_capacity = 4096;
+	};
+
+	class data_grid :
+		public widget_facade
+	{
+		struct cell_key
+		{
+			std::size_t row;
+			std::size_t column;
+
+			bool operator==(cell_key const& rhs) const noexcept
+			{
+				return row == rhs.row && column == rhs.column;
+			}
+		};
+
+		struct cell_key_hash
+		{
+			std::size_t operator()(cell_key const& k) const noexcept
+			{
+				return std::hash< std::size_t >{}( k.row * 0x9e3779b97f4a7c15ull ^ k.column );
+			}
+		};
+
+	public:
+		using cell_source = std::function< std::string (std::size_t, std::size_t) >;
+
+	private:
+		cell_source source_;
+		std::size_t rows_;
+		std::size_t header_rows_;
+		std::size_t header_columns_;
+		float row_height_;
+		float scroll_bar_width_;
+		std::vector< float > offsets_;
+		spirea::dwrite::text_format format_;
+		style_data_t< data_grid_style > cell_data_;
+		style_data_t< data_grid_style > header_data_;
+		detail::lru_cache< cell_key, spirea::dwrite::text_layout, cell_key_hash > cache_;
+		std::size_t first_row_ = 0;
+		float scroll_x_ = 0.0f;
+		widget< scroll_bar< axis_flag::vertical > > vscroll_;
+		widget< scroll_bar< axis_flag::horizontal > > hscroll_;
+		spirea::connection vscroll_conn_;
+		spirea::connection hscroll_conn_;
+
+	public:
+		template <typename Rect>
+		data_grid(
+			Rect const& rc,
+			std::size_t rows,
+			std::size_t columns,
+			cell_source source,
+			data_grid_property const& prop = {}
+		) :
+			widget_facade{ rc },
+			source_{ std::move( source ) },
+			rows_{ rows },
+			header_rows_{ std::min( prop.header_rows, rows ) },
+			header_columns_{ std::min( prop.header_columns, columns ) },
+			row_height_{ prop.row_height },
+			scroll_bar_width_{ prop.scroll_bar_width },
+			cell_data_{ deref_style< data_grid >( prop.cell_style, data_grid_part::cell ) },
+			header_data_{ deref_style< data_grid >( prop.header_style, data_grid_part::header ) },
+			cache_{ prop.cache_capacity }
+		{
+			offsets_.resize( columns + 1 );
+			offsets_[0] = 0.0f;
+			for( std::size_t i = 0; i < columns; ++i ) {
+				auto const w = i < prop.column_widths.size() ? prop.column_widths[i] : prop.default_column_width;
+				offsets_[i + 1] = offsets_[i] + w;
+			}
+
+			format_ = create_text_format( deref_text_format( prop.text_fmt ) );
+			format_->SetTextAlignment( spirea::dwrite::text_alignment::leading );
+			format_->SetParagraphAlignment( spirea::dwrite::paragraph_alignment::center );
+			format_->SetWordWrapping( DWRITE_WORD_WRAPPING_NO_WRAP );
+
+			vscroll_ = { vscroll_rect(), vertical_page(), vertical_max(), prop.scroll_bar };
+			hscroll_ = { hscroll_rect(), horizontal_page(), horizontal_max(), prop.scroll_bar };
+
+			vscroll_conn_ = vscroll_->connect( scroll_bar_event::scroll{}, [this](std::uint32_t lower, std::uint32_t) {
+				first_row_ = lower;
+			} );
+			hscroll_conn_ = hscroll_->connect( scroll_bar_event::scroll{}, [this](std::uint32_t lower, std::uint32_t) {
+				scroll_x_ = static_cast< float >( lower );
+			} );
+		}
+
+		~data_grid() noexcept
+		{
+			vscroll_conn_.disconnect();
+			hscroll_conn_.disconnect();
+			vscroll_.detach();
+			hscroll_.detach();
+		}
+
+		std::size_t size_of_rows() const noexcept
+		{
+			return rows_;
+		}
+
+		std::size_t size_of_columns() const noexcept
+		{
+			return offsets_.size() - 1;
+		}
+
+		std::size_t cached_cells() const noexcept
+		{
+			return cache_.size();
+		}
+
+		void set_source(std::size_t rows, cell_source source)
+		{
+			source_ = std::move( source );
+			rows_ = rows;
+			header_rows_ = std::min( header_rows_, rows_ );
+			if( first_row_ >= body_rows() ) {
+				first_row_ = 0;
+			}
+			vscroll_->set_values( vertical_page(), vertical_max() );
+			cache_.clear();
+		}
+
+		void set_column_width(std::size_t column, float width)
+		{
+			assert( column < size_of_columns() );
+			if( column >= size_of_columns() ) {
+				return;
+			}
+
+			auto const diff = width - ( offsets_[column + 1] - offsets_[column] );
+			for( auto i = column + 1; i < offsets_.size(); ++i ) {
+				offsets_[i] += diff;
+			}
+			hscroll_->set_values( horizontal_page(), horizontal_max() );
+			cache_.clear();
+		}
+
+		std::size_t first_row() const noexcept
+		{
+			return first_row_;
+		}
+
+		void scroll_to(std::size_t row, float x = 0.0f) noexcept
+		{
+			auto const page = std::min( vertical_page(), vertical_max() );
+			first_row_ = std::min< std::size_t >( row, vertical_max() - page );
+			scroll_x_ = std::clamp( x, 0.0f, static_cast< float >( horizontal_max() - std::min( horizontal_page(), horizontal_max() ) ) );
+			vscroll_->set_position( static_cast< std::uint32_t >( first_row_ ) );
+			hscroll_->set_position( static_cast< std::uint32_t >( scroll_x_ ) );
+			redraw();
+		}
+
+		void invalidate() noexcept
+		{
+			cache_.clear();
+		}
+
+		void invalidate(std::size_t row, std::size_t column)
+		{
+			cache_.erase( { row, column } );
+		}
+
+		template <typename Rect>
+		void resize(Rect const& rc) noexcept
+		{
+			widget_facade::resize( rc );
+			vscroll_->resize( vscroll_rect() );
+			hscroll_->resize( hscroll_rect() );
+			vscroll_->set_values( vertical_page(), vertical_max() );
+			hscroll_->set_values( horizontal_page(), horizontal_max() );
+		}
+
+		void show() noexcept
+		{
+			widget_facade::show();
+			vscroll_->show();
+			hscroll_->show();
+		}
+
+		void hide() noexcept
+		{
+			widget_facade::hide();
+			vscroll_->hide();
+			hscroll_->hide();
+		}
+
+		void on_event(event::draw, window& wnd)
+		{
+			if( !is_visible() ) {
+				return;
+			}
+
+			auto const rt = wnd.render_target();
+			auto const rc = content_rect();
+			auto const header_w = offsets_[header_columns_];
+			auto const header_h = row_height_ * header_rows_;
+			auto const body_left = rc.left + header_w;
+			auto const body_top = rc.top + header_h;
+
+			auto const visible_rows = static_cast< std::size_t >( std::ceil( std::max( rc.bottom - body_top, 0.0f ) / row_height_ ) );
+			auto const last_row = std::min( header_rows_ + first_row_ + visible_rows, rows_ );
+			auto const first_row = std::min( header_rows_ + first_row_, last_row );
+
+			auto const x0 = header_w + scroll_x_;
+			auto const first_col = column_at( x0 );
+			auto const last_col = std::min( column_at( x0 + std::max( rc.right - body_left, 0.0f ) ) + 1, size_of_columns() );
+
+			auto const visible_cells = ( last_row - first_row + header_rows_ ) * ( last_col - first_col + header_columns_ );
+			if( cache_.capacity() < visible_cells * 2 ) {
+				cache_.set_capacity( visible_cells * 2 );
+			}
+
+			cell_data_.draw_background( rt, spirea::rect_traits< spirea::d2d1::rect_f >::construct( rc ) );
+
+			auto row_y = [&](std::size_t r) {
+				return r < header_rows_ ? rc.top + row_height_ * r : body_top + row_height_ * ( r - header_rows_ - first_row_ );
+			};
+			auto col_x = [&](std::size_t c) {
+				return c < header_columns_ ? rc.left + offsets_[c] : body_left + offsets_[c] - x0;
+			};
+
+			draw_region( rt, { body_left, body_top, rc.right, rc.bottom }, first_row, last_row, first_col, last_col, cell_data_, false, row_y, col_x );
+			draw_region( rt, { body_left, rc.top, rc.right, body_top }, 0, header_rows_, first_col, last_col, header_data_, true, row_y, col_x );
+			draw_region( rt, { rc.left, body_top, body_left, rc.bottom }, first_row, last_row, 0, header_columns_, header_data_, true, row_y, col_x );
+			draw_region( rt, { rc.left, rc.top, body_left, body_top }, 0, header_rows_, 0, header_columns_, header_data_, true, row_y, col_x );
+		}
+
+		void on_event(event::recreated_target, window& wnd)
+		{
+			auto const rt = wnd.render_target();
+			cell_data_.recreated_target( rt );
+			header_data_.recreated_target( rt );
+		}
+
+		void on_event(event::attached, window& wnd)
+		{
+			vscroll_.detach();
+			hscroll_.detach();
+			wnd.attach_widget( vscroll_ );
+			wnd.attach_widget( hscroll_ );
+		}
+
+		void on_event(widget_event::detached)
+		{
+			vscroll_.detach();
+			hscroll_.detach();
+		}
+
+	private:
+		template <typename RowY, typename ColX>
+		void draw_region(
+			spirea::d2d1::render_target const& rt,
+			D2D1_RECT_F const& clip,
+			std::size_t first_row, std::size_t last_row,
+			std::size_t first_col, std::size_t last_col,
+			style_data_t< data_grid_style > const& data,
+			bool fill,
+			RowY&& row_y, ColX&& col_x
+		)
+		{
+			if( first_row >= last_row || first_col >= last_col || clip.right <= clip.left || clip.bottom <= clip.top ) {
+				return;
+			}
+
+			rt->PushAxisAlignedClip( clip, D2D1_ANTIALIAS_MODE_ALIASED );
+			for( auto r = first_row; r < last_row; ++r ) {
+				auto const y = row_y( r );
+				for( auto c = first_col; c < last_col; ++c ) {
+					auto const x = col_x( c );
+					auto const w = offsets_[c + 1] - offsets_[c];
+					auto const cell = spirea::rect_traits< spirea::d2d1::rect_f >::construct(
+						spirea::rect_t< float >{ { x, y }, { w, row_height_ } }
+					);
+
+					auto const& layout = cache_.get_or_insert( { r, c }, [&] {
+						return create_text_layout( format_, spirea::rect_t< float >{ { 0.0f, 0.0f }, { w, row_height_ } }, source_( r, c ) );
+					} );
+
+					if( fill ) {
+						data.draw_background( rt, cell );
+					}
+					data.draw_edge( rt, cell );
+					data.draw_text( rt, { x, y }, layout );
+				}
+			}
+			rt->PopAxisAlignedClip();
+		}
+
+		std::size_t column_at(float x) const noexcept
+		{
+			auto const itr = std::upper_bound( offsets_.begin(), offsets_.end(), x );
+			if( itr == offsets_.begin() ) {
+				return 0;
+			}
+			return std::min( static_cast< std::size_t >( itr - offsets_.begin() ) - 1, size_of_columns() );
+		}
+
+		std::size_t body_rows() const noexcept
+		{
+			return rows_ - header_rows_;
+		}
+
+		spirea::rect_t< float > content_rect() const noexcept
+		{
+			auto rc = size();
+			rc.right = std::max( rc.right - scroll_bar_width_, rc.left );
+			rc.bottom = std::max( rc.bottom - scroll_bar_width_, rc.top );
+			return rc;
+		}
+
+		spirea::rect_t< float > vscroll_rect() const noexcept
+		{
+			auto const rc = content_rect();
+			return { { rc.right, rc.top }, { scroll_bar_width_, rc.height() } };
+		}
+
+		spirea::rect_t< float > hscroll_rect() const noexcept
+		{
+			auto const rc = content_rect();
+			return { { rc.left, rc.bottom }, { rc.width(), scroll_bar_width_ } };
+		}
+
+		std::uint32_t vertical_page() const noexcept
+		{
+			auto const h = content_rect().height() - row_height_ * header_rows_;
+			return static_cast< std::uint32_t >( std::max( h, 0.0f ) / row_height_ );
+		}
+
+		std::uint32_t vertical_max() const noexcept
+		{
+			return static_cast< std::uint32_t >( body_rows() );
+		}
+
+		std::uint32_t horizontal_page() const noexcept
+		{
+			auto const w = content_rect().width() - offsets_[header_columns_];
+			return static_cast< std::uint32_t >( std::max( w, 0.0f ) );
+		}
+
+		std::uint32_t horizontal_max() const noexcept
+		{
+			return static_cast< std::uint32_t >( offsets_.back() - offsets_[header_columns_] );
+		}
+	};
+
+	using auto_scaling_data_grid = auto_resizer< data_grid >;
+
+} // namespace musket
+
+#endif // MUSKET_WIDGET_DATA_GRID_HPP_
\ No newline at end of file
@@ -24,6 +24,7 @@ namespace musket {
 	{
 		spirea::rect_t< float > rc_;
 		bool visibility_;
+		std::weak_ptr< detail::window_context > wnd_;
 
 	public:
 		template <typename Rect>
@@ -50,12 +51,28 @@ namespace musket {
 
 		void show() noexcept
 		{
-			visibility_ = true;
+			if( !visibility_ ) {
+				visibility_ = true;
+				redraw();
+			}
 		}
 
 		void hide() noexcept
 		{
-			visibility_ = false;
+			if( visibility_ ) {
+				visibility_ = false;
+				redraw();
+			}
+		}
+
+		void redraw() const noexcept
+		{
+			detail::invalidate_widget( wnd_, rc_ );
+		}
+
+		void bind_window(std::weak_ptr< detail::window_context > const& wnd) noexcept
+		{
+			wnd_ = wnd;
 		}
 	};
 
@@ -12,14 +12,16 @@
 
 #include "facade.hpp"
 #include "attributes.hpp"
+#include "prepared_text.hpp"
+#include "shared_style.hpp"
 
 namespace musket {
 
 	struct label_style
 	{
-		std::optional< rgba_color_t > bg_color;
+		std::optional< rgba8 > bg_color;
 		std::optional< edge_property > edge;
-		std::optional< rgba_color_t > text_color;
+		std::optional< rgba8 > text_color;
 	};
 
 	class label;
@@ -60,7 +62,7 @@ namespace musket {
 		std::string str_;
 		spirea::dwrite::text_format format_;
 		spirea::dwrite::text_layout text_;
-		style_data_t< label_style > data_;
+		shared_style< label_style > data_;
 
 	public:
 		template <typename Rect>
@@ -68,15 +70,33 @@ namespace musket {
 			Rect const& rc,
 			std::string_view str,
 			label_property const& prop = {}
+		) :
+			label{ rc, prepare_text( request_text( rc, str, prop ) ), prop }
+		{ }
+
+		template <typename Rect>
+		label(
+			Rect const& rc,
+			prepared_text text,
+			label_property const& prop = {}
 		) :
 			widget_facade{ rc },
-			str_{ str.begin(), str.end() },
+			str_{ std::move( text.str ) },
+			format_{ std::move( text.format ) },
+			text_{ std::move( text.layout ) },
 			data_{ deref_style< label >( prop.style ) }
+		{ }
+
+		template <typename Rect>
+		static text_request request_text(Rect const& rc, std::string_view str, label_property const& prop = {})
 		{
-			format_ = create_text_format( deref_text_format( prop.text_fmt ) );
-			format_->SetTextAlignment( spirea::dwrite::text_alignment::center );
-			format_->SetParagraphAlignment( spirea::dwrite::paragraph_alignment::center );
-			text_ = create_text_layout( format_, this->size(), str );
+			return {
+				deref_text_format( prop.text_fmt ),
+				spirea::dwrite::text_alignment::center,
+				spirea::dwrite::paragraph_alignment::center,
+				spirea::rect_traits< spirea::rect_t< float > >::construct( rc ),
+				std::string{ str.begin(), str.end() }
+			};
 		}
 
 		void set_text(std::string_view str)
@@ -93,9 +113,9 @@ namespace musket {
 			auto const rc = spirea::rect_traits< spirea::d2d1::rect_f >::construct( this->size() );
 			auto const rt = wnd.render_target();
 
-			data_.draw_background( rt, rc );
-			data_.draw_edge( rt, rc );
-			data_.draw_text( rt, { rc.left, rc.top }, text_ );
+			data_->draw_background( rt, rc );
+			data_->draw_edge( rt, rc );
+			data_->draw_text( rt, { rc.left, rc.top }, text_ );
 		}
 
 		void on_event(event::recreated_target, window& wnd)
@@ -0,0 +1,295 @@
+//--------------------------------------------------------
+// musket/include/musket/widget/list_view.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_WIDGET_LIST_VIEW_HPP_
+#define MUSKET_WIDGET_LIST_VIEW_HPP_
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <iterator>
+#include <vector>
+#include <functional>
+#include "facade.hpp"
+#include "../widget.hpp"
+#include "scroll_bar.hpp"
+
+namespace musket {
+
+	struct list_view_style
+	{
+		std::optional< rgba8 > bg_color;
+		std::optional< edge_property > edge;
+		std::optional< rgba8 > text_color;
+	};
+
+	class list_view;
+
+	template <>
+	class default_style_t< list_view >
+	{
+		inline static list_view_style style_ = {
+			rgba_color_t{ 0.15f, 0.15f, 0.15f, 1.0f },
+			musket::edge_property{ { 0.5f, 0.5f, 0.5f, 1.0f }, 1.0f },
+			rgba_color_t{ 1.0f, 1.0f, 1.0f, 1.0f },
+		};
+
+		inline static std::mutex mtx_;
+
+	public:
+		static void set(list_view_style const& style) noexcept
+		{
+			std::lock_guard lock{ mtx_ };
+			style_ = style;
+		}
+
+		static list_view_style get() noexcept
+		{
+			std::lock_guard lock{ mtx_ };
+			return style_;
+		}
+	};
+
+	struct list_view_property
+	{
+		std::optional< text_format > text_fmt = {};
+		std::optional< list_view_style > style = {};
+		scroll_bar_property scroll_bar = {};
+		float row_height = 20.0f;
+		float scroll_bar_width = 16.0f;
+	};
+
+	class list_view :
+		public widget_facade
+	{
+		static constexpr std::size_t npos = std::numeric_limits< std::size_t >::max();
+
+		struct row
+		{
+			std::size_t index = npos;
+			spirea::dwrite::text_layout layout;
+		};
+
+	public:
+		using row_source = std::function< std::string (std::size_t) >;
+
+	private:
+		row_source source_;
+		std::size_t count_;
+		float row_height_;
+		float scroll_bar_width_;
+		spirea::dwrite::text_format format_;
+		style_data_t< list_view_style > data_;
+		std::vector< row > rows_;
+		std::size_t first_ = 0;
+		widget< scroll_bar< axis_flag::vertical > > scroll_;
+		spirea::connection scroll_conn_;
+
+	public:
+		template <typename Rect>
+		list_view(
+			Rect const& rc,
+			std::size_t count,
+			row_source source,
+			list_view_property const& prop = {}
+		) :
+			widget_facade{ rc },
+			source_{ std::move( source ) },
+			count_{ count },
+			row_height_{ prop.row_height },
+			scroll_bar_width_{ prop.scroll_bar_width },
+			data_{ deref_style< list_view >( prop.style ) }
+		{
+			format_ = create_text_format( deref_text_format( prop.text_fmt ) );
+			format_->SetTextAlignment( spirea::dwrite::text_alignment::leading );
+			format_->SetParagraphAlignment( spirea::dwrite::paragraph_alignment::center );
+			format_->SetWordWrapping( DWRITE_WORD_WRAPPING_NO_WRAP );
+
+			scroll_ = { scroll_bar_rect(), static_cast< std::uint32_t >( visible_rows() ), static_cast< std::uint32_t >( count_ ), prop.scroll_bar };
+			scroll_conn_ = scroll_->connect( scroll_bar_event::scroll{}, [this](std::uint32_t lower, std::uint32_t) {
+				first_ = lower;
+			} );
+
+			rows_.resize( visible_rows() + 1 );
+		}
+
+		template <typename Rect, typename Range>
+		list_view(
+			Rect const& rc,
+			Range const& range,
+			list_view_property const& prop = {}
+		) :
+			list_view{
+				rc, static_cast< std::size_t >( std::size( range ) ),
+				[items = copy_range( range )](std::size_t i) { return ( *items )[i]; },
+				prop
+			}
+		{ }
+
+		~list_view() noexcept
+		{
+			scroll_conn_.disconnect();
+			scroll_.detach();
+		}
+
+		std::size_t size_of_rows() const noexcept
+		{
+			return count_;
+		}
+
+		std::size_t first_visible_row() const noexcept
+		{
+			return first_;
+		}
+
+		void set_source(std::size_t count, row_source source)
+		{
+			source_ = std::move( source );
+			set_count( count );
+		}
+
+		void set_count(std::size_t count) noexcept
+		{
+			count_ = count;
+			if( first_ >= count_ ) {
+				first_ = count_ > 0 ? count_ - 1 : 0;
+			}
+			scroll_->set_values( static_cast< std::uint32_t >( visible_rows() ), static_cast< std::uint32_t >( count_ ) );
+			invalidate();
+		}
+
+		void invalidate() noexcept
+		{
+			for( auto& r : rows_ ) {
+				r.index = npos;
+			}
+		}
+
+		void invalidate(std::size_t index) noexcept
+		{
+			auto& r = rows_[index % rows_.size()];
+			if( r.index == index ) {
+				r.index = npos;
+			}
+		}
+
+		template <typename Rect>
+		void resize(Rect const& rc) noexcept
+		{
+			widget_facade::resize( rc );
+			scroll_->resize( scroll_bar_rect() );
+			scroll_->set_values( static_cast< std::uint32_t >( visible_rows() ), static_cast< std::uint32_t >( count_ ) );
+
+			rows_.clear();
+			rows_.resize( visible_rows() + 1 );
+		}
+
+		void show() noexcept
+		{
+			widget_facade::show();
+			scroll_->show();
+		}
+
+		void hide() noexcept
+		{
+			widget_facade::hide();
+			scroll_->hide();
+		}
+
+		void on_event(event::draw, window& wnd)
+		{
+			if( !is_visible() ) {
+				return;
+			}
+
+			auto const rt = wnd.render_target();
+			auto const rc = content_rect();
+			auto const rcf = spirea::rect_traits< spirea::d2d1::rect_f >::construct( rc );
+
+			data_.draw_background( rt, rcf );
+
+			rt->PushAxisAlignedClip( rcf, D2D1_ANTIALIAS_MODE_ALIASED );
+			auto const visible = rows_.size();
+			for( std::size_t i = 0; i < visible && first_ + i < count_; ++i ) {
+				auto const& r = acquire( first_ + i, rc.width() );
+				data_.draw_text( rt, { rc.left, rc.top + row_height_ * i }, r.layout );
+			}
+			rt->PopAxisAlignedClip();
+
+			data_.draw_edge( rt, rcf );
+		}
+
+		void on_event(event::recreated_target, window& wnd)
+		{
+			data_.recreated_target( wnd.render_target() );
+		}
+
+		void on_event(event::attached, window& wnd)
+		{
+			scroll_.detach();
+			wnd.attach_widget( scroll_ );
+		}
+
+		void on_event(widget_event::detached)
+		{
+			scroll_.detach();
+		}
+
+	private:
+		template <typename Range>
+		static std::shared_ptr< std::vector< std::string > const > copy_range(Range const& range)
+		{
+			auto items = std::make_shared< std::vector< std::string > >();
+			items->reserve( static_cast< std::size_t >( std::size( range ) ) );
+			for( auto const& i : range ) {
+				items->emplace_back( std::string_view{ i } );
+			}
+			return items;
+		}
+
+		spirea::rect_t< float > content_rect() const noexcept
+		{
+			auto rc = size();
+			rc.right -= scroll_bar_width_;
+			if( rc.right < rc.left ) {
+				rc.right = rc.left;
+			}
+			return rc;
+		}
+
+		spirea::rect_t< float > scroll_bar_rect() const noexcept
+		{
+			auto const rc = size();
+			return { { rc.right - scroll_bar_width_, rc.top }, { scroll_bar_width_, rc.height() } };
+		}
+
+		std::size_t visible_rows() const noexcept
+		{
+			return static_cast< std::size_t >( std::ceil( size().height() / row_height_ ) );
+		}
+
+		row const& acquire(std::size_t index, float width)
+		{
+			auto& r = rows_[index % rows_.size()];
+			if( r.index != index ) {
+				r.layout = create_text_layout(
+					format_, spirea::rect_t< float >{ { 0.0f, 0.0f }, { width, row_height_ } }, source_( index )
+				);
+				r.index = index;
+			}
+			return r;
+		}
+	};
+
+	using auto_scaling_list_view = auto_resizer< list_view >;
+
+} // namespace musket
+
+#endif // MUSKET_WIDGET_LIST_VIEW_HPP_
\ No newline at end of file
@@ -0,0 +1,417 @@
+//--------------------------------------------------------
+// musket/include/musket/widget/plot.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_WIDGET_PLOT_HPP_
+#define MUSKET_WIDGET_PLOT_HPP_
+
+#include <vector>
+#include <atomic>
+#include <limits>
+#include <algorithm>
+#include "facade.hpp"
+#include "../detail/mpsc_queue.hpp"
+
+#if defined( _M_X64 ) || defined( __SSE2__ )
+#include <emmintrin.h>
+#define MUSKET_PLOT_USE_SSE2
+#endif
+
+namespace musket {
+
+	struct plot_style
+	{
+		std::optional< rgba8 > fg_color;
+		std::optional< rgba8 > bg_color;
+		std::optional< edge_property > edge;
+	};
+
+	class plot;
+
+	template <>
+	class default_style_t< plot >
+	{
+		inline static plot_style style_ = {
+			rgba_color_t{ 0.3f, 0.85f, 0.4f, 1.0f },
+			rgba_color_t{ 0.1f, 0.1f, 0.1f, 1.0f },
+			musket::edge_property{ { 0.5f, 0.5f, 0.5f, 1.0f }, 1.0f },
+		};
+
+		inline static std::mutex mtx_;
+
+	public:
+		static void set(plot_style const& style) noexcept
+		{
+			std::lock_guard lock{ mtx_ };
+			style_ = style;
+		}
+
+		static plot_style get() noexcept
+		{
+			std::lock_guard lock{ mtx_ };
+			return style_;
+		}
+	};
+
+	struct plot_range
+	{
+		float lower;
+		float upper;
+	};
+
+	struct plot_property
+	{
+		std::optional< plot_style > style = {};
+		std::optional< plot_range > range = {};
+		std::size_t history = 1 << 20;
+		std::size_t span = 1 << 16;
+		std::size_t queue_capacity = 1 << 16;
+		float line_width = 1.0f;
+	};
+
+namespace detail {
+
+	struct min_max
+	{
+		float min;
+		float max;
+	};
+
+	inline min_max find_min_max(float const* p, std::size_t n, min_max acc) noexcept
+	{
+		std::size_t i = 0;
+
+#ifdef MUSKET_PLOT_USE_SSE2
+		if( n >= 8 ) {
+			auto lo = _mm_set1_ps( acc.min );
+			auto hi = _mm_set1_ps( acc.max );
+			for( ; i + 8 <= n; i += 8 ) {
+				auto const a = _mm_loadu_ps( p + i );
+				auto const b = _mm_loadu_ps( p + i + 4 );
+				lo = _mm_min_ps( lo, _mm_min_ps( a, b ) );
+				hi = _mm_max_ps( hi, _mm_max_ps( a, b ) );
+			}
+			lo = _mm_min_ps( lo, _mm_shuffle_ps( lo, lo, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+			lo = _mm_min_ps( lo, _mm_shuffle_ps( lo, lo, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+			hi = _mm_max_ps( hi, _mm_shuffle_ps( hi, hi, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+			hi = _mm_max_ps( hi, _mm_shuffle_ps( hi, hi, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+			acc.min = _mm_cvtss_f32( lo );
+			acc.max = _mm_cvtss_f32( hi );
+		}
+#endif
+
+		for( ; i < n; ++i ) {
+			acc.min = std::min( acc.min, p[i] );
+			acc.max = std::max( acc.max, p[i] );
+		}
+
+		return acc;
+	}
+
+	class plot_queue
+	{
+		mpsc_queue< float > queue_;
+		std::atomic< std::uint64_t > dropped_{ 0 };
+		frame_requester frames_;
+
+	public:
+		explicit plot_queue(std::size_t capacity) :
+			queue_{ capacity }
+		{ }
+
+		bool push(float v)
+		{
+			if( queue_.try_push( v ) ) {
+				frames_.request();
+				return true;
+			}
+			dropped_.fetch_add( 1, std::memory_order_relaxed );
+			return false;
+		}
+
+		std::uint64_t dropped() const noexcept
+		{
+			return dropped_.load( std::memory_order_relaxed );
+		}
+
+		bool empty() const noexcept
+		{
+			return queue_.empty();
+		}
+
+		frame_requester& frames() noexcept
+		{
+			return frames_;
+		}
+
+		template <typename F>
+		std::size_t consume(F&& f, std::size_t max_count)
+		{
+			return queue_.consume( std::forward< F >( f ), max_count );
+		}
+	};
+
+} // namespace detail
+
+	class plot_source
+	{
+		std::shared_ptr< detail::plot_queue > p_;
+
+	public:
+		plot_source() = default;
+
+		explicit plot_source(std::shared_ptr< detail::plot_queue > const& p) :
+			p_{ p }
+		{ }
+
+		bool push(float v) const
+		{
+			assert( p_ );
+			return p_->push( v );
+		}
+
+		template <typename InputIterator>
+		std::size_t push(InputIterator first, InputIterator last) const
+		{
+			assert( p_ );
+			std::size_t n = 0;
+			for( ; first != last; ++first ) {
+				if( p_->push( static_cast< float >( *first ) ) ) {
+					++n;
+				}
+			}
+			return n;
+		}
+
+		std::uint64_t dropped() const noexcept
+		{
+			assert( p_ );
+			return p_->dropped();
+		}
+	};
+
+	class plot :
+		public widget_facade
+	{
+		std::shared_ptr< detail::plot_queue > queue_;
+		std::vector< float > history_;
+		std::size_t head_ = 0;
+		std::size_t count_ = 0;
+		std::size_t span_;
+		std::optional< plot_range > range_;
+		float line_width_;
+		style_data_t< plot_style > data_;
+		std::vector< detail::min_max > columns_;
+		std::vector< D2D1_POINT_2F > points_;
+
+	public:
+		template <typename Rect>
+		plot(
+			Rect const& rc,
+			plot_property const& prop = {}
+		) :
+			widget_facade{ rc },
+			queue_{ std::make_shared< detail::plot_queue >( prop.queue_capacity ) },
+			history_( std::max< std::size_t >( prop.history, 1 ) ),
+			span_{ std::clamp< std::size_t >( prop.span, 1, history_.size() ) },
+			range_{ prop.range },
+			line_width_{ prop.line_width },
+			data_{ deref_style< plot >( prop.style ) }
+		{ }
+
+		plot_source source() const noexcept
+		{
+			return plot_source{ queue_ };
+		}
+
+		std::size_t size_of_samples() const noexcept
+		{
+			return count_;
+		}
+
+		std::size_t span() const noexcept
+		{
+			return span_;
+		}
+
+		void set_span(std::size_t span) noexcept
+		{
+			span_ = std::clamp< std::size_t >( span, 1, history_.size() );
+		}
+
+		void set_range(std::optional< plot_range > const& range) noexcept
+		{
+			range_ = range;
+		}
+
+		void clear() noexcept
+		{
+			head_ = 0;
+			count_ = 0;
+		}
+
+		void on_event(event::idle, window& wnd)
+		{
+			queue_->frames().reset();
+			if( drain() > 0 && is_visible() ) {
+				wnd.redraw( size() );
+			}
+			if( !queue_->empty() ) {
+				wnd.request_idle_frame();
+			}
+		}
+
+		void on_event(event::draw, window& wnd)
+		{
+			drain();
+
+			if( !is_visible() ) {
+				return;
+			}
+
+			auto const rt = wnd.render_target();
+			auto const rc = size();
+			auto const rcf = spirea::rect_traits< spirea::d2d1::rect_f >::construct( rc );
+
+			data_.draw_background( rt, rcf );
+
+			if( build_polyline( rt, rc ) ) {
+				spirea::d2d1::path_geometry geometry;
+				spirea::windows::try_hresult( context().d2d1->CreatePathGeometry( geometry.pp() ) );
+
+				spirea::d2d1::geometry_sink sink;
+				spirea::windows::try_hresult( geometry->Open( sink.pp() ) );
+				sink->BeginFigure( points_.front(), D2D1_FIGURE_BEGIN_HOLLOW );
+				sink->AddLines( points_.data() + 1, static_cast< UINT32 >( points_.size() - 1 ) );
+				sink->EndFigure( D2D1_FIGURE_END_OPEN );
+				spirea::windows::try_hresult( sink->Close() );
+
+				rt->PushAxisAlignedClip( rcf, D2D1_ANTIALIAS_MODE_ALIASED );
+				data_.draw_foreground( rt, geometry, line_width_ );
+				rt->PopAxisAlignedClip();
+			}
+
+			data_.draw_edge( rt, rcf );
+		}
+
+		void on_event(event::recreated_target, window& wnd)
+		{
+			data_.recreated_target( wnd.render_target() );
+		}
+
+		void on_event(event::attached, window& wnd)
+		{
+			queue_->frames().bind( wnd.window_handle().handle() );
+		}
+
+	private:
+		std::size_t drain()
+		{
+			auto const cap = history_.size();
+			return queue_->consume( [this, cap](float v) {
+				history_[head_] = v;
+				head_ = head_ + 1 == cap ? 0 : head_ + 1;
+				if( count_ < cap ) {
+					++count_;
+				}
+			}, cap );
+		}
+
+		template <typename F>
+		void for_each_chunk(std::size_t first, std::size_t n, F&& f) const
+		{
+			auto const cap = history_.size();
+			auto const begin = ( head_ + cap - count_ + first ) % cap;
+			auto const head = std::min( n, cap - begin );
+
+			f( history_.data() + begin, head );
+			if( head < n ) {
+				f( history_.data(), n - head );
+			}
+		}
+
+		detail::min_max min_max_of(std::size_t first, std::size_t n) const noexcept
+		{
+			detail::min_max acc = { std::numeric_limits< float >::max(), std::numeric_limits< float >::lowest() };
+			for_each_chunk( first, n, [&acc](float const* p, std::size_t len) {
+				acc = detail::find_min_max( p, len, acc );
+			} );
+			return acc;
+		}
+
+		bool build_polyline(spirea::d2d1::render_target const& rt, spirea::rect_t< float > const& rc)
+		{
+			auto const n = std::min( span_, count_ );
+			if( n < 2 ) {
+				return false;
+			}
+
+			float dpi_x, dpi_y;
+			rt->GetDpi( &dpi_x, &dpi_y );
+			auto const cols = std::max< std::size_t >(
+				static_cast< std::size_t >( rc.width() * dpi_x / spirea::windows::api::user_default_screen_dpi< float > ), 1
+			);
+			auto const first = count_ - n;
+
+			points_.clear();
+
+			detail::min_max bounds;
+			if( n <= cols * 2 ) {
+				bounds = min_max_of( first, n );
+			}
+			else {
+				columns_.resize( cols );
+				bounds = { std::numeric_limits< float >::max(), std::numeric_limits< float >::lowest() };
+				for( std::size_t j = 0; j < cols; ++j ) {
+					auto const b = n * j / cols;
+					auto const e = n * ( j + 1 ) / cols;
+					columns_[j] = min_max_of( first + b, e - b );
+					bounds.min = std::min( bounds.min, columns_[j].min );
+					bounds.max = std::max( bounds.max, columns_[j].max );
+				}
+			}
+			if( range_ ) {
+				bounds = { range_->lower, range_->upper };
+			}
+
+			auto const height = rc.height();
+			auto const extent = bounds.max - bounds.min;
+			auto to_y = [&](float v) {
+				if( extent <= 0.0f ) {
+					return rc.top + height * 0.5f;
+				}
+				return rc.bottom - ( v - bounds.min ) / extent * height;
+			};
+
+			if( n <= cols * 2 ) {
+				points_.reserve( n );
+				auto const step = rc.width() / static_cast< float >( n - 1 );
+				std::size_t i = 0;
+				for_each_chunk( first, n, [&](float const* p, std::size_t len) {
+					for( std::size_t k = 0; k < len; ++k, ++i ) {
+						points_.push_back( { rc.left + step * i, to_y( p[k] ) } );
+					}
+				} );
+			}
+			else {
+				points_.reserve( cols * 2 );
+				auto const step = rc.width() / static_cast< float >( cols );
+				for( std::size_t j = 0; j < cols; ++j ) {
+					auto const x = rc.left + step * ( static_cast< float >( j ) + 0.5f );
+					points_.push_back( { x, to_y( columns_[j].min ) } );
+					points_.push_back( { x, to_y( columns_[j].max ) } );
+				}
+			}
+
+			return true;
+		}
+	};
+
+} // namespace musket
+
+#endif // MUSKET_WIDGET_PLOT_HPP_
\ No newline at end of file
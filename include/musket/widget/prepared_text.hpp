@@ -0,0 +1,212 @@
+//--------------------------------------------------------
+// musket/include/musket/widget/prepared_text.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_WIDGET_PREPARED_TEXT_HPP_
+#define MUSKET_WIDGET_PREPARED_TEXT_HPP_
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <string>
+#include <exception>
+#include <functional>
+#include <unordered_map>
+#include <condition_variable>
+#include "style.hpp"
+#include "../detail/thread_pool.hpp"
+
+namespace musket {
+
+	struct text_request
+	{
+		text_format format;
+		DWRITE_TEXT_ALIGNMENT text_align;
+		DWRITE_PARAGRAPH_ALIGNMENT paragraph_align;
+		spirea::rect_t< float > rc;
+		std::string str;
+	};
+
+	struct prepared_text
+	{
+		std::string str;
+		spirea::dwrite::text_format format;
+		spirea::dwrite::text_layout layout;
+	};
+
+namespace detail {
+
+	class text_format_cache
+	{
+		struct key
+		{
+			text_format format;
+			DWRITE_TEXT_ALIGNMENT text_align;
+			DWRITE_PARAGRAPH_ALIGNMENT paragraph_align;
+
+			bool operator==(key const& rhs) const noexcept
+			{
+				return format.name == rhs.format.name
+					&& format.size == rhs.format.size
+					&& format.weight == rhs.format.weight
+					&& format.style == rhs.format.style
+					&& format.stretch == rhs.format.stretch
+					&& text_align == rhs.text_align
+					&& paragraph_align == rhs.paragraph_align;
+			}
+		};
+
+		struct key_hash
+		{
+			std::size_t operator()(key const& k) const noexcept
+			{
+				auto h = std::hash< std::string >{}( k.format.name );
+				auto combine = [&h](std::size_t v) {
+					h ^= v + 0x9e3779b9 + ( h << 6 ) + ( h >> 2 );
+				};
+				combine( std::hash< float >{}( k.format.size ) );
+				combine( static_cast< std::size_t >( k.format.weight ) );
+				combine( static_cast< std::size_t >( k.format.style ) );
+				combine( static_cast< std::size_t >( k.format.stretch ) );
+				combine( static_cast< std::size_t >( k.text_align ) );
+				combine( static_cast< std::size_t >( k.paragraph_align ) );
+				return h;
+			}
+		};
+
+		std::mutex mtx_;
+		std::unordered_map< key, spirea::dwrite::text_format, key_hash > formats_;
+
+	public:
+		static text_format_cache& instance()
+		{
+			static text_format_cache obj;
+			return obj;
+		}
+
+		spirea::dwrite::text_format get(text_format const& tf, DWRITE_TEXT_ALIGNMENT text_align, DWRITE_PARAGRAPH_ALIGNMENT paragraph_align)
+		{
+			key k = { tf, text_align, paragraph_align };
+			{
+				std::lock_guard lock{ mtx_ };
+				auto const itr = formats_.find( k );
+				if( itr != formats_.end() ) {
+					return itr->second;
+				}
+			}
+
+			auto format = create_text_format( tf );
+			format->SetTextAlignment( text_align );
+			format->SetParagraphAlignment( paragraph_align );
+
+			std::lock_guard lock{ mtx_ };
+			return formats_.emplace( std::move( k ), format ).first->second;
+		}
+
+		void clear()
+		{
+			std::lock_guard lock{ mtx_ };
+			formats_.clear();
+		}
+	};
+
+} // namespace detail
+
+	inline spirea::dwrite::text_format cached_text_format(text_format const& tf, DWRITE_TEXT_ALIGNMENT text_align, DWRITE_PARAGRAPH_ALIGNMENT paragraph_align)
+	{
+		return detail::text_format_cache::instance().get( tf, text_align, paragraph_align );
+	}
+
+	inline prepared_text prepare_text(text_request const& req)
+	{
+		auto format = cached_text_format( req.format, req.text_align, req.paragraph_align );
+		auto layout = create_text_layout( format, req.rc, req.str );
+		return { req.str, std::move( format ), std::move( layout ) };
+	}
+
+namespace detail {
+
+	struct prepare_texts_state
+	{
+		std::vector< text_request > const* reqs;
+		std::vector< prepared_text > results;
+		std::size_t chunks;
+		std::atomic< std::size_t > next{ 0 };
+
+		std::mutex mtx;
+		std::condition_variable cv;
+		std::size_t done = 0;
+		std::exception_ptr error;
+
+		static constexpr std::size_t chunk_size = 32;
+
+		bool run_chunk()
+		{
+			auto const chunk = next.fetch_add( 1, std::memory_order_relaxed );
+			if( chunk >= chunks ) {
+				return false;
+			}
+
+			auto const first = chunk * chunk_size;
+			auto const last = std::min( first + chunk_size, reqs->size() );
+			std::exception_ptr e;
+			try {
+				for( auto i = first; i < last; ++i ) {
+					results[i] = prepare_text( ( *reqs )[i] );
+				}
+			}
+			catch( ... ) {
+				e = std::current_exception();
+			}
+
+			std::lock_guard lock{ mtx };
+			if( e && !error ) {
+				error = e;
+			}
+			if( ++done == chunks ) {
+				cv.notify_one();
+			}
+			return true;
+		}
+	};
+
+} // namespace detail
+
+	inline std::vector< prepared_text > prepare_texts(std::vector< text_request > const& reqs, detail::thread_pool& pool = detail::default_thread_pool())
+	{
+		if( reqs.empty() ) {
+			return {};
+		}
+
+		auto state = std::make_shared< detail::prepare_texts_state >();
+		state->reqs = &reqs;
+		state->results.resize( reqs.size() );
+		state->chunks = ( reqs.size() + detail::prepare_texts_state::chunk_size - 1 ) / detail::prepare_texts_state::chunk_size;
+
+		auto const helpers = std::min( pool.size(), state->chunks - 1 );
+		for( std::size_t i = 0; i < helpers; ++i ) {
+			pool.submit( [state] {
+				while( state->run_chunk() ) {}
+			} );
+		}
+
+		while( state->run_chunk() ) {}
+
+		std::unique_lock lock{ state->mtx };
+		state->cv.wait( lock, [&state] { return state->done == state->chunks; } );
+		if( state->error ) {
+			std::rethrow_exception( state->error );
+		}
+
+		return std::move( state->results );
+	}
+
+} // namespace musket
+
+#endif // MUSKET_WIDGET_PREPARED_TEXT_HPP_
\ No newline at end of file
@@ -13,6 +13,8 @@
 #include "facade.hpp"
 #include "../widget.hpp"
 #include "button.hpp"
+#include "transition.hpp"
+#include "shared_style.hpp"
 
 namespace musket {
 
@@ -32,14 +34,14 @@ namespace scroll_bar_event {
 
 	struct scroll_bar_style
 	{
-		std::optional< rgba_color_t > bg_color;
+		std::optional< rgba8 > bg_color;
 		std::optional< edge_property > edge;
 		float min_thumb_size;
 	};
 
 	struct scroll_bar_thumb_style
 	{
-		std::optional< rgba_color_t > fg_color;
+		std::optional< rgba8 > fg_color;
 		std::optional< edge_property > edge;
 	};
 
@@ -120,6 +122,7 @@ namespace scroll_bar_event {
 		std::optional< scroll_bar_thumb_style > idle_style;
 		std::optional< scroll_bar_thumb_style > over_style;
 		std::optional< scroll_bar_thumb_style > pressed_style;
+		std::chrono::milliseconds transition = default_transition_duration;
 	};
 
 	template <axis_flag>
@@ -132,13 +135,14 @@ namespace detail {
 		public widget_facade
 	{
 		using state = scroll_bar_thumb_state;
-		using style_data_type = style_data_t< scroll_bar_thumb_style >;
+		using style_data_type = shared_style< scroll_bar_thumb_style >;
 		using state_machine_type = state_machine<
 			style_data_type, state, state::idle, state::over, state::pressed
 		>;
 
 		Parent* parent_;
 		state_machine_type states_;
+		style_transition< scroll_bar_thumb_style > transition_;
 		spirea::point_t< std::int32_t > prev_pt_;
 		spirea::connection conn_sliding_;
 		spirea::connection conn_finish_sliding_;
@@ -151,7 +155,8 @@ namespace detail {
 			spirea::rect_t< float > const& rc,
 			scroll_bar_thumb_style const& idle_style,
 			scroll_bar_thumb_style const& over_style,
-			scroll_bar_thumb_style const& pressed_style
+			scroll_bar_thumb_style const& pressed_style,
+			std::chrono::milliseconds transition = default_transition_duration
 		) :
 			widget_facade{ rc },
 			parent_{ parent },
@@ -160,7 +165,8 @@ namespace detail {
 				style_data_type{ idle_style }, 
 				style_data_type{ over_style }, 
 				style_data_type{ pressed_style }
-			}
+			},
+			transition_{ transition }
 		{ }
 
 		~scroll_bar_thumb() noexcept
@@ -179,6 +185,22 @@ namespace detail {
 			return pos_;
 		}
 
+		void set_position(std::uint32_t pos) noexcept
+		{
+			auto const rc = this->size();
+			auto const parent_rc = parent_->size();
+			auto const range = parent_->max_value() > parent_->page_value() ? parent_->max_value() - parent_->page_value() : 0u;
+
+			pos_ = std::min( pos, range );
+			auto const ratio = range > 0 ? static_cast< float >( pos_ ) / static_cast< float >( range ) : 0.0f;
+			if constexpr( Direction == axis_flag::vertical ) {
+				resize( spirea::rect_t< float >{ { rc.left, parent_rc.top + ( parent_rc.height() - rc.height() ) * ratio }, rc.area() } );
+			}
+			else {
+				resize( spirea::rect_t< float >{ { parent_rc.left + ( parent_rc.width() - rc.width() ) * ratio, rc.top }, rc.area() } );
+			}
+		}
+
 		void on_event(event::draw, window& wnd)
 		{
 			if( !is_visible() ) {
@@ -187,7 +209,7 @@ namespace detail {
 
 			auto const rc = spirea::rect_traits< spirea::d2d1::rect_f >::construct( this->size() );
 			auto const rt = wnd.render_target();
-			auto const& data = states_.get();
+			auto const& data = transition_.get( rt, *states_.get() );
 
 			data.draw_foreground( rt, rc );
 			data.draw_edge( rt, rc );
@@ -198,11 +220,13 @@ namespace detail {
 			for( auto& i : states_.data() ) {
 				i.recreated_target( wnd.render_target() );
 			}
+			transition_.recreated_target( wnd.render_target() );
 		}
+
 		void on_event(event::mouse_button_pressed, window& wnd, mouse_button btn, mouse_button, spirea::point_t< std::int32_t > const& pt)
 		{
 			if( spirea::enabled( btn, mouse_button::left ) ) {
-				states_.trasition( state::pressed );
+				change_state( wnd, state::pressed );
 				press_left_button( wnd, pt );
 			}
 		}
@@ -210,31 +234,38 @@ namespace detail {
 		void on_event(event::mouse_button_released, window& wnd, mouse_button btn, mouse_button, spirea::point_t< std::int32_t > const&)
 		{
 			if( spirea::enabled( btn, mouse_button::left ) ) {
-				states_.trasition( state::over );
-				wnd.redraw();
+				change_state( wnd, state::over );
 			}
 		}
 
 		void on_event(event::mouse_entered, window& wnd, mouse_button btns)
 		{
 			if( spirea::enabled( btns, mouse_button::left ) ) {
-				states_.trasition( state::pressed );
+				change_state( wnd, state::pressed );
 			}
 			else {
-				states_.trasition( state::over );
+				change_state( wnd, state::over );
 			}
-			wnd.redraw();
 		}
 
 		void on_event(event::mouse_leaved, window& wnd, mouse_button)
 		{
 			if( !conn_sliding_.is_connected() ) {
-				states_.trasition( state::idle );
+				change_state( wnd, state::idle );
 			}
-			wnd.redraw();
 		}
 
 	private:
+		void change_state(window& wnd, state s)
+		{
+			if( states_.state() != s ) {
+				auto const prev = states_.get().get_style();
+				states_.trasition( s );
+				transition_.start( wnd, prev, states_.get().get_style(), size() );
+			}
+			wnd.redraw( size() );
+		}
+
 		void press_left_button(window& wnd, spirea::point_t< std::int32_t > const& pt)
 		{
 			prev_pt_ = pt;
@@ -285,8 +316,7 @@ namespace detail {
 				event::mouse_button_released{}, 
 				[this](window& wnd, mouse_button btn, mouse_button, spirea::point_t< std::int32_t > const&) mutable {
 					if( spirea::enabled( btn, mouse_button::left ) ) {
-						states_.trasition( state::idle );
-						wnd.redraw();
+						change_state( wnd, state::idle );
 
 						conn_sliding_.disconnect();
 						conn_finish_sliding_.disconnect();
@@ -331,7 +361,8 @@ namespace detail {
 				spirea::rect_t< float >{ { rc.left, rc.top }, get_thumb_size( sd_.get_style() ) }, 
 				deref_style< scroll_bar >( prop.idle_style, scroll_bar_thumb_state::idle ), 
 				deref_style< scroll_bar >( prop.over_style, scroll_bar_thumb_state::over ),
-				deref_style< scroll_bar >( prop.pressed_style, scroll_bar_thumb_state::pressed ) 
+				deref_style< scroll_bar >( prop.pressed_style, scroll_bar_thumb_state::pressed ),
+				prop.transition
 			};
 		}
 
@@ -352,14 +383,15 @@ namespace detail {
 		{
 			widget_facade::resize( rc );
 
-			spirea::point_t< float > pt;
-			if constexpr( Direction == axis_flag::vertical ) {
-				pt.x = rc.left;
-				pt.y = rc.top + rc.height() * static_cast< float >( thumb_->position() ) / static_cast< float >( max_value() - page_value() );
-			}
-			else {
-				pt.x = rc.left + rc.width() * static_cast< float >( thumb_->position() ) / static_cast< float >( max_value() - page_value() );
-				pt.y = rc.top;
+			spirea::point_t< float > pt = { rc.left, rc.top };
+			if( max_value() > page_value() ) {
+				auto const ratio = static_cast< float >( thumb_->position() ) / static_cast< float >( max_value() - page_value() );
+				if constexpr( Direction == axis_flag::vertical ) {
+					pt.y += rc.height() * ratio;
+				}
+				else {
+					pt.x += rc.width() * ratio;
+				}
 			}
 
 			thumb_->resize( spirea::rect_t{ pt, get_thumb_size( sd_.get_style() ) } );
@@ -380,6 +412,11 @@ namespace detail {
 			return thumb_->position();
 		}
 
+		void set_position(std::uint32_t pos) noexcept
+		{
+			thumb_->set_position( pos );
+		}
+
 		void set_values(std::uint32_t page_value, std::uint32_t max_value) noexcept
 		{
 			auto const thumb_rc = thumb_->size();
@@ -387,7 +424,7 @@ namespace detail {
 			page_value_ = page_value;
 			max_value_ = max_value;
 			
-			thumb_->resize( spirea::rect_t{ spirea::point_t{ thumb_rc.left, thumb_rc.top }, get_thumb_size( sd_.style ) } );
+			thumb_->resize( spirea::rect_t{ spirea::point_t{ thumb_rc.left, thumb_rc.top }, get_thumb_size( sd_.get_style() ) } );
 		} 
 
 		template <typename Event, typename F>
@@ -416,9 +453,15 @@ namespace detail {
 
 		void on_event(event::attached, window& wnd)
 		{
+			thumb_.detach();
 			wnd.attach_widget( thumb_ );
 		}
 
+		void on_event(widget_event::detached)
+		{
+			thumb_.detach();
+		}
+
 	private:
 		spirea::area_t< float > get_thumb_size(scroll_bar_style const& style) const noexcept
 		{
@@ -0,0 +1,432 @@
+//--------------------------------------------------------
+// musket/include/musket/widget/scroll_view.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_WIDGET_SCROLL_VIEW_HPP_
+#define MUSKET_WIDGET_SCROLL_VIEW_HPP_
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <functional>
+#include "facade.hpp"
+#include "../widget.hpp"
+#include "scroll_bar.hpp"
+
+namespace musket {
+
+	struct scroll_view_style
+	{
+		std::optional< rgba8 > bg_color;
+		std::optional< edge_property > edge;
+	};
+
+	template <axis_flag>
+	class scroll_view;
+
+	template <axis_flag Axis>
+	class default_style_t< scroll_view< Axis > >
+	{
+		inline static scroll_view_style style_ = {};
+
+		inline static std::mutex mtx_ = {};
+
+	public:
+		static void set(scroll_view_style const& style) noexcept
+		{
+			std::lock_guard lock{ mtx_ };
+			style_ = style;
+		}
+
+		static scroll_view_style get() noexcept
+		{
+			std::lock_guard lock{ mtx_ };
+			return style_;
+		}
+	};
+
+	struct scroll_view_property
+	{
+		std::optional< scroll_view_style > style;
+	};
+
+	template <axis_flag Direction>
+	class scroll_view :
+		public widget_facade
+	{
+		static_assert( Direction == axis_flag::vertical || Direction == axis_flag::horizontal );
+
+		using style_data_type = style_data_t< scroll_view_style >;
+		using children_handler_type = event_handler< window, window_events, detail::event_handler_element_to_widget >;
+
+		style_data_type sd_;
+		float extent_;
+		float offset_ = 0.0f;
+		std::int32_t drawn_pixels_ = 0;
+		bool dirty_ = true;
+		spirea::d2d1::bitmap_render_target front_;
+		spirea::d2d1::bitmap_render_target back_;
+		children_handler_type children_;
+		std::vector< event_connections< window_events > > conns_;
+		std::vector< std::function< void (window&) > > initializers_;
+		spirea::connection scroll_conn_;
+		std::function< void (std::uint32_t) > sync_scroll_bar_;
+
+	public:
+		template <typename Rect>
+		scroll_view(
+			Rect const& rc,
+			float extent,
+			scroll_view_property const& prop = {}
+		) :
+			widget_facade{ rc },
+			sd_{ deref_style< scroll_view >( prop.style ) },
+			extent_{ extent }
+		{ }
+
+		~scroll_view() noexcept
+		{
+			scroll_conn_.disconnect();
+			for( auto& i : conns_ ) {
+				i.disconnect_all();
+			}
+		}
+
+		template <typename T>
+		void attach_widget(widget< T >& w)
+		{
+			conns_.push_back( connect_events( children_, w ) );
+			initializers_.push_back( [w](window& wnd) mutable {
+				if constexpr( has_on_event< widget< T >, event::attached, void (window&) >::value ) {
+					w->on_event( event::attached{}, wnd );
+				}
+			} );
+			dirty_ = true;
+		}
+
+		template <typename ScrollBar>
+		void link(widget< ScrollBar >& sb)
+		{
+			sb->set_values( static_cast< std::uint32_t >( viewport_length() ), static_cast< std::uint32_t >( extent_ ) );
+
+			scroll_conn_.disconnect();
+			scroll_conn_ = sb->connect( scroll_bar_event::scroll{}, [this](std::uint32_t lower, std::uint32_t) {
+				set_offset( static_cast< float >( lower ) );
+			} );
+			sync_scroll_bar_ = [sb](std::uint32_t pos) mutable {
+				sb->set_position( pos );
+				sb->redraw();
+			};
+		}
+
+		float extent() const noexcept
+		{
+			return extent_;
+		}
+
+		void set_extent(float extent) noexcept
+		{
+			extent_ = extent;
+			scroll_to( offset_ );
+			dirty_ = true;
+		}
+
+		float offset() const noexcept
+		{
+			return offset_;
+		}
+
+		void scroll_to(float offset) noexcept
+		{
+			if( set_offset( offset ) && sync_scroll_bar_ ) {
+				sync_scroll_bar_( static_cast< std::uint32_t >( offset_ ) );
+			}
+		}
+
+		void invalidate() noexcept
+		{
+			dirty_ = true;
+		}
+
+		template <typename Rect>
+		void resize(Rect const& rc) noexcept
+		{
+			widget_facade::resize( rc );
+			front_.reset();
+			back_.reset();
+			dirty_ = true;
+		}
+
+		void on_event(event::draw, window& wnd)
+		{
+			if( !is_visible() ) {
+				return;
+			}
+
+			auto const rt = wnd.render_target();
+
+			if( !initializers_.empty() ) {
+				for( auto& f : initializers_ ) {
+					f( wnd );
+				}
+				initializers_.clear();
+				dirty_ = true;
+			}
+			if( !front_ || !back_ ) {
+				create_cache( rt );
+			}
+
+			float dpi_x, dpi_y;
+			rt->GetDpi( &dpi_x, &dpi_y );
+			float const scale = ( Direction == axis_flag::vertical ? dpi_y : dpi_x ) / spirea::windows::api::user_default_screen_dpi< float >;
+
+			auto const pixels = static_cast< std::int32_t >( std::round( offset_ * scale ) );
+			auto const shift = pixels - drawn_pixels_;
+			auto const pixel_sz = front_->GetPixelSize();
+			auto const length = static_cast< std::int32_t >( Direction == axis_flag::vertical ? pixel_sz.height : pixel_sz.width );
+
+			if( dirty_ || std::abs( shift ) >= length ) {
+				render( wnd, pixels, 0, length, scale );
+			}
+			else if( shift != 0 ) {
+				scroll_pixels( shift, pixel_sz );
+				if( shift > 0 ) {
+					render( wnd, pixels, length - shift, length, scale );
+				}
+				else {
+					render( wnd, pixels, 0, -shift, scale );
+				}
+			}
+			drawn_pixels_ = pixels;
+			dirty_ = false;
+
+			if( !front_ ) {
+				return;
+			}
+
+			spirea::d2d1::bitmap bmp;
+			spirea::windows::try_hresult( front_->GetBitmap( bmp.pp() ) );
+
+			auto const rc = spirea::rect_traits< spirea::d2d1::rect_f >::construct( size() );
+			rt->DrawBitmap( bmp.get(), rc, 1.0f, D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR, nullptr );
+			sd_.draw_edge( rt, rc );
+		}
+
+		void on_event(event::recreated_target, window& wnd)
+		{
+			sd_.recreated_target( wnd.render_target() );
+			front_.reset();
+			back_.reset();
+			dirty_ = true;
+		}
+
+		void on_event(event::idle, window& wnd)
+		{
+			auto scope = children_scope( wnd );
+			children_.invoke( event::idle{}, wnd );
+		}
+
+		void on_event(event::resized, window& wnd, spirea::area_t< std::uint32_t > const& sz)
+		{
+			auto scope = children_scope( wnd );
+			children_.invoke( event::resized{}, wnd, sz );
+		}
+
+		void on_event(event::mouse_button_pressed, window& wnd, mouse_button btn, mouse_button btns, cursor_position const& pt)
+		{
+			auto scope = children_scope( wnd );
+			auto const cpt = to_content( pt );
+			children_.invoke( event::mouse_button_pressed{}, cpt, wnd, btn, btns, cpt );
+		}
+
+		void on_event(event::mouse_button_released, window& wnd, mouse_button btn, mouse_button btns, cursor_position const& pt)
+		{
+			auto scope = children_scope( wnd );
+			auto const cpt = to_content( pt );
+			children_.invoke( event::mouse_button_released{}, cpt, wnd, btn, btns, cpt );
+		}
+
+		void on_event(event::mouse_moved, window& wnd, mouse_button btns, cursor_position const& pt)
+		{
+			auto scope = children_scope( wnd );
+			children_.invoke( event::detail::mouse_moved_distributor{}, to_content( pt ), wnd, btns );
+		}
+
+		void on_event(event::mouse_leaved, window& wnd, mouse_button btns)
+		{
+			auto scope = children_scope( wnd );
+			children_.invoke( event::detail::mouse_moved_distributor{}, event::mouse_leaved{}, wnd, btns );
+		}
+
+	private:
+		bool set_offset(float offset) noexcept
+		{
+			auto const max_offset = std::max( extent_ - viewport_length(), 0.0f );
+			auto const prev = offset_;
+			offset_ = std::clamp( offset, 0.0f, max_offset );
+			if( offset_ == prev ) {
+				return false;
+			}
+			redraw();
+			return true;
+		}
+
+		invalidation_scope children_scope(window& wnd)
+		{
+			return { wnd, [this, &wnd](std::optional< spirea::rect_t< float > > const& rc) {
+				auto const view = size();
+				if( rc ) {
+					auto const r = to_window( *rc );
+					if( r.right <= view.left || r.left >= view.right || r.bottom <= view.top || r.top >= view.bottom ) {
+						return;
+					}
+				}
+				dirty_ = true;
+				wnd.redraw( view );
+			}, content_origin() };
+		}
+
+		spirea::point_t< float > content_origin() const noexcept
+		{
+			auto const view = size();
+			return {
+				view.left - ( Direction == axis_flag::horizontal ? offset_ : 0.0f ),
+				view.top - ( Direction == axis_flag::vertical ? offset_ : 0.0f ),
+			};
+		}
+
+		spirea::rect_t< float > to_window(spirea::rect_t< float > rc) const noexcept
+		{
+			auto const origin = content_origin();
+			rc.left += origin.x;
+			rc.right += origin.x;
+			rc.top += origin.y;
+			rc.bottom += origin.y;
+			return rc;
+		}
+
+		float viewport_length() const noexcept
+		{
+			auto const rc = size();
+			return Direction == axis_flag::vertical ? rc.height() : rc.width();
+		}
+
+		cursor_position to_content(cursor_position const& pt) const noexcept
+		{
+			auto const rc = size();
+			cursor_position cpt = {
+				pt.x - static_cast< std::int32_t >( rc.left ),
+				pt.y - static_cast< std::int32_t >( rc.top ),
+			};
+
+			if constexpr( Direction == axis_flag::vertical ) {
+				cpt.y += static_cast< std::int32_t >( offset_ );
+			}
+			else {
+				cpt.x += static_cast< std::int32_t >( offset_ );
+			}
+
+			return cpt;
+		}
+
+		void create_cache(spirea::d2d1::render_target const& rt)
+		{
+			auto const sz = D2D1::SizeF( size().width(), size().height() );
+
+			front_.reset();
+			back_.reset();
+			spirea::windows::try_hresult( rt->CreateCompatibleRenderTarget( sz, front_.pp() ) );
+			spirea::windows::try_hresult( rt->CreateCompatibleRenderTarget( sz, back_.pp() ) );
+			dirty_ = true;
+		}
+
+		void scroll_pixels(std::int32_t shift, D2D1_SIZE_U const& sz)
+		{
+			spirea::d2d1::bitmap src;
+			spirea::d2d1::bitmap dst;
+			spirea::windows::try_hresult( front_->GetBitmap( src.pp() ) );
+			spirea::windows::try_hresult( back_->GetBitmap( dst.pp() ) );
+
+			auto const n = static_cast< std::uint32_t >( std::abs( shift ) );
+			D2D1_POINT_2U dst_pt = { 0, 0 };
+			D2D1_RECT_U src_rc = { 0, 0, sz.width, sz.height };
+
+			if constexpr( Direction == axis_flag::vertical ) {
+				if( shift > 0 ) {
+					src_rc.top = n;
+				}
+				else {
+					src_rc.bottom = sz.height - n;
+					dst_pt.y = n;
+				}
+			}
+			else {
+				if( shift > 0 ) {
+					src_rc.left = n;
+				}
+				else {
+					src_rc.right = sz.width - n;
+					dst_pt.x = n;
+				}
+			}
+
+			spirea::windows::try_hresult( dst->CopyFromBitmap( &dst_pt, src.get(), &src_rc ) );
+			std::swap( front_, back_ );
+		}
+
+		void render(window& wnd, std::int32_t pixels, std::int32_t begin, std::int32_t end, float scale)
+		{
+			auto const sz = front_->GetSize();
+			auto const origin = static_cast< float >( pixels ) / scale;
+			auto const first = static_cast< float >( pixels + begin ) / scale;
+			auto const last = static_cast< float >( pixels + end ) / scale;
+
+			spirea::rect_t< float > band;
+			D2D1_MATRIX_3X2_F transform;
+			if constexpr( Direction == axis_flag::vertical ) {
+				band = { { 0.0f, first }, { sz.width, last - first } };
+				transform = D2D1::Matrix3x2F::Translation( 0.0f, -origin );
+			}
+			else {
+				band = { { first, 0.0f }, { last - first, sz.height } };
+				transform = D2D1::Matrix3x2F::Translation( -origin, 0.0f );
+			}
+			auto const clip = spirea::rect_traits< spirea::d2d1::rect_f >::construct( band );
+
+			render_target_scope scope{ wnd, front_ };
+			auto children = children_scope( wnd );
+
+			front_->BeginDraw();
+			front_->SetTransform( transform );
+			front_->PushAxisAlignedClip( clip, D2D1_ANTIALIAS_MODE_ALIASED );
+			front_->Clear( spirea::d2d1::color_f{ 0.0f, 0.0f, 0.0f, 0.0f } );
+			sd_.draw_background( front_, clip );
+
+			children_.invoke( event::draw{}, wnd );
+
+			front_->PopAxisAlignedClip();
+			front_->SetTransform( D2D1::Matrix3x2F::Identity() );
+
+			auto const res = front_->EndDraw();
+			if( res != S_OK ) {
+				front_.reset();
+				back_.reset();
+				dirty_ = true;
+				if( res != D2DERR_RECREATE_TARGET ) {
+					throw spirea::windows::hresult_error( res );
+				}
+			}
+		}
+	};
+
+	template <axis_flag Direction>
+	using auto_scaling_scroll_view = auto_resizer< scroll_view< Direction > >;
+
+} // namespace musket
+
+#endif // MUSKET_WIDGET_SCROLL_VIEW_HPP_
\ No newline at end of file
@@ -0,0 +1,296 @@
+//--------------------------------------------------------
+// musket/include/musket/widget/shared_style.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_WIDGET_SHARED_STYLE_HPP_
+#define MUSKET_WIDGET_SHARED_STYLE_HPP_
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include "style.hpp"
+
+namespace musket {
+
+namespace style_detail {
+
+	template <typename Color>
+	inline bool equal_color(Color const& a, Color const& b) noexcept
+	{
+		using traits = rgba_color_traits< Color >;
+		return traits::red( a ) == traits::red( b ) && traits::green( a ) == traits::green( b )
+			&& traits::blue( a ) == traits::blue( b ) && traits::alpha( a ) == traits::alpha( b );
+	}
+
+	template <typename Color>
+	inline bool equal_optional(std::optional< Color > const& a, std::optional< Color > const& b) noexcept
+	{
+		return a && b ? equal_color( *a, *b ) : !a && !b;
+	}
+
+	inline bool equal_optional(std::optional< edge_property > const& a, std::optional< edge_property > const& b) noexcept
+	{
+		return a && b ? equal_color( a->color, b->color ) && a->size == b->size : !a && !b;
+	}
+
+	inline void hash_combine(std::size_t& seed, float v) noexcept
+	{
+		std::uint32_t bits;
+		std::memcpy( &bits, &v, sizeof( bits ) );
+		seed ^= std::hash< std::uint32_t >{}( bits ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+	}
+
+	template <typename Color>
+	inline void hash_optional(std::size_t& seed, std::optional< Color > const& c) noexcept
+	{
+		using traits = rgba_color_traits< Color >;
+
+		hash_combine( seed, c ? 1.0f : 0.0f );
+		if( c ) {
+			hash_combine( seed, static_cast< float >( traits::red( *c ) ) );
+			hash_combine( seed, static_cast< float >( traits::green( *c ) ) );
+			hash_combine( seed, static_cast< float >( traits::blue( *c ) ) );
+			hash_combine( seed, static_cast< float >( traits::alpha( *c ) ) );
+		}
+	}
+
+	inline void hash_optional(std::size_t& seed, std::optional< edge_property > const& e) noexcept
+	{
+		hash_optional( seed, e ? std::optional< rgba8 >{ e->color } : std::nullopt );
+		if( e ) {
+			hash_combine( seed, e->size );
+		}
+	}
+
+	template <typename StyleType>
+	struct style_equal
+	{
+		bool operator()(StyleType const& a, StyleType const& b) const noexcept
+		{
+			bool res = true;
+			if constexpr( has_fg_color< StyleType >::value != location::none ) {
+				res = res && equal_optional( a.fg_color, b.fg_color );
+			}
+			if constexpr( has_bg_color< StyleType >::value != location::none ) {
+				res = res && equal_optional( a.bg_color, b.bg_color );
+			}
+			if constexpr( has_edge< StyleType >::value != location::none ) {
+				res = res && equal_optional( a.edge, b.edge );
+			}
+			if constexpr( has_text_color< StyleType >::value != location::none ) {
+				res = res && equal_optional( a.text_color, b.text_color );
+			}
+			return res;
+		}
+	};
+
+	template <typename StyleType>
+	struct style_hash
+	{
+		std::size_t operator()(StyleType const& s) const noexcept
+		{
+			std::size_t seed = 0;
+			if constexpr( has_fg_color< StyleType >::value != location::none ) {
+				hash_optional( seed, s.fg_color );
+			}
+			if constexpr( has_bg_color< StyleType >::value != location::none ) {
+				hash_optional( seed, s.bg_color );
+			}
+			if constexpr( has_edge< StyleType >::value != location::none ) {
+				hash_optional( seed, s.edge );
+			}
+			if constexpr( has_text_color< StyleType >::value != location::none ) {
+				hash_optional( seed, s.text_color );
+			}
+			return seed;
+		}
+	};
+
+	template <typename StyleType>
+	class style_node
+	{
+		struct resource
+		{
+			spirea::d2d1::render_target target;
+			std::weak_ptr< style_data_t< StyleType > > data;
+		};
+
+		StyleType style_;
+		std::vector< resource > resources_;
+
+	public:
+		explicit style_node(StyleType const& style) :
+			style_{ style }
+		{ }
+
+		StyleType const& get_style() const noexcept
+		{
+			return style_;
+		}
+
+		std::size_t size_of_resources() const noexcept
+		{
+			std::size_t n = 0;
+			for( auto const& r : resources_ ) {
+				n += r.data.expired() ? 0 : 1;
+			}
+			return n;
+		}
+
+		std::shared_ptr< style_data_t< StyleType > > acquire(spirea::d2d1::render_target const& rt)
+		{
+			resources_.erase(
+				std::remove_if( resources_.begin(), resources_.end(), [](auto const& r) { return r.data.expired(); } ),
+				resources_.end()
+			);
+
+			for( auto const& r : resources_ ) {
+				if( r.target.get() == rt.get() ) {
+					if( auto p = r.data.lock() ) {
+						return p;
+					}
+				}
+			}
+
+			auto p = std::make_shared< style_data_t< StyleType > >( style_ );
+			p->recreated_target( rt );
+			resources_.push_back( { rt, p } );
+			return p;
+		}
+	};
+
+} // namespace style_detail
+
+	struct style_memory_report
+	{
+		std::size_t size_of_styles = 0;
+		std::size_t size_of_resources = 0;
+		std::size_t size_of_references = 0;
+		std::size_t memory_usage = 0;
+	};
+
+namespace detail {
+
+	template <typename StyleType>
+	class style_pool
+	{
+		using node_type = style_detail::style_node< StyleType >;
+
+		std::mutex mtx_;
+		std::unordered_multimap< std::size_t, std::weak_ptr< node_type > > table_;
+
+	public:
+		static style_pool& instance()
+		{
+			static style_pool pool;
+			return pool;
+		}
+
+		std::shared_ptr< node_type > intern(StyleType const& style)
+		{
+			auto const h = style_detail::style_hash< StyleType >{}( style );
+
+			std::lock_guard lock{ mtx_ };
+			auto [first, last] = table_.equal_range( h );
+			while( first != last ) {
+				auto p = first->second.lock();
+				if( !p ) {
+					first = table_.erase( first );
+					continue;
+				}
+				if( style_detail::style_equal< StyleType >{}( p->get_style(), style ) ) {
+					return p;
+				}
+				++first;
+			}
+
+			auto p = std::make_shared< node_type >( style );
+			table_.emplace( h, p );
+			return p;
+		}
+
+		std::shared_ptr< style_data_t< StyleType > > acquire(std::shared_ptr< node_type > const& node, spirea::d2d1::render_target const& rt)
+		{
+			std::lock_guard lock{ mtx_ };
+			return node->acquire( rt );
+		}
+
+		style_memory_report report()
+		{
+			std::lock_guard lock{ mtx_ };
+
+			style_memory_report r;
+			for( auto const& i : table_ ) {
+				auto const p = i.second.lock();
+				if( !p ) {
+					continue;
+				}
+				++r.size_of_styles;
+				r.size_of_resources += p->size_of_resources();
+				r.size_of_references += static_cast< std::size_t >( p.use_count() - 1 );
+			}
+			r.memory_usage = r.size_of_styles * sizeof( node_type ) + r.size_of_resources * sizeof( style_data_t< StyleType > );
+			return r;
+		}
+	};
+
+} // namespace detail
+
+	template <typename StyleType>
+	class shared_style
+	{
+		using node_type = style_detail::style_node< StyleType >;
+		using data_type = style_data_t< StyleType >;
+
+		std::shared_ptr< node_type > node_;
+		std::shared_ptr< data_type > data_;
+
+	public:
+		shared_style() = default;
+
+		shared_style(StyleType const& style) :
+			node_{ detail::style_pool< StyleType >::instance().intern( style ) }
+		{ }
+
+		StyleType const& get_style() const noexcept
+		{
+			assert( node_ );
+			return node_->get_style();
+		}
+
+		void recreated_target(spirea::d2d1::render_target const& rt)
+		{
+			assert( node_ );
+			data_ = detail::style_pool< StyleType >::instance().acquire( node_, rt );
+		}
+
+		data_type const& operator*() const noexcept
+		{
+			assert( data_ );
+			return *data_;
+		}
+
+		data_type const* operator->() const noexcept
+		{
+			assert( data_ );
+			return data_.get();
+		}
+	};
+
+	template <typename StyleType>
+	inline style_memory_report style_memory_usage()
+	{
+		return detail::style_pool< StyleType >::instance().report();
+	}
+
+} // namespace musket
+
+#endif // MUSKET_WIDGET_SHARED_STYLE_HPP_
\ No newline at end of file
@@ -0,0 +1,227 @@
+//--------------------------------------------------------
+// musket/include/musket/widget/static_panel.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_WIDGET_STATIC_PANEL_HPP_
+#define MUSKET_WIDGET_STATIC_PANEL_HPP_
+
+#include <tuple>
+#include <limits>
+#include <utility>
+#include <type_traits>
+#include "facade.hpp"
+#include "../widget.hpp"
+
+namespace musket {
+
+namespace detail {
+
+	template <typename Widget, typename Event, typename Args, typename = void>
+	struct has_panel_handler :
+		std::false_type
+	{ };
+
+	template <typename Widget, typename Event, typename... Args>
+	struct has_panel_handler<
+		Widget, Event, void (Args...),
+		std::void_t< decltype( std::declval< Widget& >().on_event( Event{}, std::declval< window& >(), std::declval< Args >()... ) ) >
+	> :
+		std::true_type
+	{ };
+
+	template <typename Widget, typename Event, typename... Args>
+	inline void invoke_panel_handler(Widget& w, Event, window& wnd, Args const&... args)
+	{
+		if constexpr( has_panel_handler< Widget, Event, void (Args const&...) >::value ) {
+			w.on_event( Event{}, wnd, args... );
+		}
+	}
+
+	template <typename Widget>
+	inline void bind_panel_window(Widget& w, std::weak_ptr< window_context > const& wnd) noexcept
+	{
+		if constexpr( has_bind_window< Widget >::value ) {
+			w.bind_window( wnd );
+		}
+	}
+
+	inline bool contains(spirea::rect_t< float > const& rc, cursor_position const& pt) noexcept
+	{
+		return pt.x >= rc.left && pt.x <= rc.right && pt.y >= rc.top && pt.y <= rc.bottom;
+	}
+
+} // namespace detail
+
+	template <typename... Widgets>
+	class static_panel :
+		public widget_facade
+	{
+		static constexpr std::size_t npos = std::numeric_limits< std::size_t >::max();
+
+		std::tuple< Widgets... > widgets_;
+		std::size_t over_ = npos;
+
+	public:
+		template <typename Rect, typename... Args>
+		static_panel(Rect const& rc, Args&&... args) :
+			widget_facade{ rc },
+			widgets_{ std::forward< Args >( args )... }
+		{ }
+
+		template <std::size_t I>
+		auto& get() noexcept
+		{
+			return std::get< I >( widgets_ );
+		}
+
+		template <std::size_t I>
+		auto const& get() const noexcept
+		{
+			return std::get< I >( widgets_ );
+		}
+
+		static constexpr std::size_t size_of_widgets() noexcept
+		{
+			return sizeof...( Widgets );
+		}
+
+		void bind_window(std::weak_ptr< detail::window_context > const& wnd) noexcept
+		{
+			widget_facade::bind_window( wnd );
+			std::apply( [&](auto&... w) {
+				( ..., detail::bind_panel_window( w, wnd ) );
+			}, widgets_ );
+		}
+
+		void on_event(event::idle, window& wnd)
+		{
+			broadcast( event::idle{}, wnd );
+		}
+
+		void on_event(event::draw, window& wnd)
+		{
+			if( is_visible() ) {
+				broadcast( event::draw{}, wnd );
+			}
+		}
+
+		void on_event(event::detail::draw_static, window& wnd)
+		{
+			if( is_visible() ) {
+				broadcast( event::detail::draw_static{}, wnd );
+			}
+		}
+
+		void on_event(event::recreated_target, window& wnd)
+		{
+			broadcast( event::recreated_target{}, wnd );
+		}
+
+		void on_event(event::attached, window& wnd)
+		{
+			broadcast( event::attached{}, wnd );
+		}
+
+		void on_event(event::resized, window& wnd, spirea::area_t< std::uint32_t > const& sz)
+		{
+			broadcast( event::resized{}, wnd, sz );
+		}
+
+		void on_event(event::mouse_button_pressed, window& wnd, mouse_button btn, mouse_button btns, cursor_position const& pt)
+		{
+			visit( hit_test( pt ), [&](auto& w) {
+				detail::invoke_panel_handler( w, event::mouse_button_pressed{}, wnd, btn, btns, pt );
+			} );
+		}
+
+		void on_event(event::mouse_button_released, window& wnd, mouse_button btn, mouse_button btns, cursor_position const& pt)
+		{
+			visit( hit_test( pt ), [&](auto& w) {
+				detail::invoke_panel_handler( w, event::mouse_button_released{}, wnd, btn, btns, pt );
+			} );
+		}
+
+		void on_event(event::mouse_moved, window& wnd, mouse_button btns, cursor_position const& pt)
+		{
+			auto const hit = hit_test( pt );
+			if( hit == over_ ) {
+				visit( hit, [&](auto& w) {
+					detail::invoke_panel_handler( w, event::mouse_moved{}, wnd, btns, pt );
+				} );
+				return;
+			}
+
+			visit( over_, [&](auto& w) {
+				detail::invoke_panel_handler( w, event::mouse_leaved{}, wnd, btns );
+			} );
+			visit( hit, [&](auto& w) {
+				detail::invoke_panel_handler( w, event::mouse_entered{}, wnd, btns );
+			} );
+			over_ = hit;
+		}
+
+		void on_event(event::mouse_leaved, window& wnd, mouse_button btns)
+		{
+			visit( over_, [&](auto& w) {
+				detail::invoke_panel_handler( w, event::mouse_leaved{}, wnd, btns );
+			} );
+			over_ = npos;
+		}
+
+		void on_event(event::key_pressed, window& wnd, virtual_key key)
+		{
+			broadcast( event::key_pressed{}, wnd, key );
+		}
+
+		void on_event(event::char_input, window& wnd, char32_t ch)
+		{
+			broadcast( event::char_input{}, wnd, ch );
+		}
+
+		void on_event(event::detail::auto_resize, window& wnd, spirea::point_t< float > const& offset)
+		{
+			broadcast( event::detail::auto_resize{}, wnd, offset );
+		}
+
+		void on_event(event::detail::auto_relocation, window& wnd, spirea::point_t< float > const& offset)
+		{
+			broadcast( event::detail::auto_relocation{}, wnd, offset );
+		}
+
+	private:
+		template <typename Event, typename... Args>
+		void broadcast(Event, window& wnd, Args const&... args)
+		{
+			std::apply( [&](auto&... w) {
+				( ..., detail::invoke_panel_handler( w, Event{}, wnd, args... ) );
+			}, widgets_ );
+		}
+
+		template <typename F>
+		void visit(std::size_t i, F&& f)
+		{
+			std::apply( [&](auto&... w) {
+				std::size_t n = 0;
+				( ..., ( n++ == i ? void( f( w ) ) : void() ) );
+			}, widgets_ );
+		}
+
+		std::size_t hit_test(cursor_position const& pt) const noexcept
+		{
+			std::size_t hit = npos;
+			std::apply( [&](auto const&... w) {
+				std::size_t n = 0;
+				( ..., ( detail::contains( w.size(), pt ) && w.is_visible() ? void( hit = n++ ) : void( ++n ) ) );
+			}, widgets_ );
+			return hit;
+		}
+	};
+
+} // namespace musket
+
+#endif // MUSKET_WIDGET_STATIC_PANEL_HPP_
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include <spirea/windows/dwrite.hpp>
 #include "../context.hpp"
 #include "../color.hpp"
+#include "../trace.hpp"
 
 namespace musket {
 
@@ -56,6 +57,8 @@ namespace musket {
 
 	inline spirea::dwrite::text_format create_text_format(text_format const& tf) 
 	{
+		trace_scope scope{ "text", "create_text_format" };
+
 		spirea::dwrite::text_format format;
 		spirea::windows::try_hresult( context().dwrite->CreateTextFormat(
 			spirea::windows::multibyte_to_widechar( spirea::windows::code_page::utf8, tf.name ).c_str(),
@@ -71,6 +74,8 @@ namespace musket {
 	template <typename Rect>
 	inline spirea::dwrite::text_layout create_text_layout(spirea::dwrite::text_format const& format, Rect const& rc, std::string_view str)
 	{
+		trace_scope scope{ "text", "create_text_layout" };
+
 		spirea::dwrite::text_layout layout;
 		std::wstring const wstr = spirea::windows::multibyte_to_widechar( spirea::windows::code_page::utf8, str );
 		spirea::windows::try_hresult( context().dwrite->CreateTextLayout(
@@ -85,7 +90,7 @@ namespace musket {
 
 	struct edge_property
 	{
-		rgba_color_t color;
+		rgba8 color;
 		float size = 1.0f;
 	};
 
@@ -220,6 +225,22 @@ namespace style_detail {
 			rt->CreateSolidColorBrush( color, brush_.pp() );
 		}
 
+		template <typename StyleType>
+		void update(spirea::d2d1::render_target const& rt, StyleType const& style)
+		{
+			if( !style.fg_color ) {
+				brush_.reset();
+				return;
+			}
+			auto const color = rgba_color_traits< spirea::d2d1::color_f >::construct( *style.fg_color );
+			if( brush_ ) {
+				brush_->SetColor( color );
+			}
+			else {
+				rt->CreateSolidColorBrush( color, brush_.pp() );
+			}
+		}
+
 	public:
 		void draw_foreground(spirea::d2d1::render_target const& rt, spirea::d2d1::rect_f const& rc) const
 		{
@@ -228,6 +249,14 @@ namespace style_detail {
 			}
 			rt->FillRectangle( rc, brush_.get() );
 		}
+
+		void draw_foreground(spirea::d2d1::render_target const& rt, spirea::d2d1::path_geometry const& geometry, float width) const
+		{
+			if( !brush_ ) {
+				return;
+			}
+			rt->DrawGeometry( geometry.get(), brush_.get(), width );
+		}
 	};
 
 	template <>
@@ -246,6 +275,22 @@ namespace style_detail {
 			rt->CreateSolidColorBrush( color, brush_.pp() );
 		}
 
+		template <typename StyleType>
+		void update(spirea::d2d1::render_target const& rt, StyleType const& style)
+		{
+			if( !style.bg_color ) {
+				brush_.reset();
+				return;
+			}
+			auto const color = rgba_color_traits< spirea::d2d1::color_f >::construct( *style.bg_color );
+			if( brush_ ) {
+				brush_->SetColor( color );
+			}
+			else {
+				rt->CreateSolidColorBrush( color, brush_.pp() );
+			}
+		}
+
 	public:
 		void draw_background(spirea::d2d1::render_target const& rt, spirea::d2d1::rect_f const& rc) const
 		{
@@ -274,6 +319,23 @@ namespace style_detail {
 			sz_ = style.edge->size;
 		}
 
+		template <typename StyleType>
+		void update(spirea::d2d1::render_target const& rt, StyleType const& style)
+		{
+			if( !style.edge ) {
+				brush_.reset();
+				return;
+			}
+			auto const color = rgba_color_traits< spirea::d2d1::color_f >::construct( style.edge->color );
+			if( brush_ ) {
+				brush_->SetColor( color );
+			}
+			else {
+				rt->CreateSolidColorBrush( color, brush_.pp() );
+			}
+			sz_ = style.edge->size;
+		}
+
 	public:
 		void draw_edge(spirea::d2d1::render_target const& rt, spirea::d2d1::rect_f const& rc) const
 		{
@@ -300,6 +362,22 @@ namespace style_detail {
 			rt->CreateSolidColorBrush( color, brush_.pp() );
 		}
 
+		template <typename StyleType>
+		void update(spirea::d2d1::render_target const& rt, StyleType const& style)
+		{
+			if( !style.text_color ) {
+				brush_.reset();
+				return;
+			}
+			auto const color = rgba_color_traits< spirea::d2d1::color_f >::construct( *style.text_color );
+			if( brush_ ) {
+				brush_->SetColor( color );
+			}
+			else {
+				rt->CreateSolidColorBrush( color, brush_.pp() );
+			}
+		}
+
 	public:
 		void draw_text(spirea::d2d1::render_target const& rt, spirea::d2d1::point_2f const& pt, spirea::dwrite::text_layout const& layout) const
 		{
@@ -310,6 +388,23 @@ namespace style_detail {
 		}
 	};
 
+	template <typename T>
+	inline std::optional< T > lerp_optional(std::optional< T > const& a, std::optional< T > const& b, float t) noexcept
+	{
+		if( a && b ) {
+			return lerp_color( *a, *b, t );
+		}
+		return t < 0.5f ? a : b;
+	}
+
+	inline std::optional< edge_property > lerp_optional(std::optional< edge_property > const& a, std::optional< edge_property > const& b, float t) noexcept
+	{
+		if( a && b ) {
+			return edge_property{ lerp_color( a->color, b->color, t ), a->size + ( b->size - a->size ) * t };
+		}
+		return t < 0.5f ? a : b;
+	}
+
 } // namespace style_detail
 
 	template <typename StyleType, typename = style_detail::make_location_holder< StyleType >>
@@ -335,10 +430,38 @@ namespace style_detail {
 
 		void recreated_target(spirea::d2d1::render_target const& rt)
 		{
+			trace_scope scope{ "resource", trace_type< StyleType >{} };
 			( ..., style_detail::style_adapter< Locs >::recreated_target( rt, style_ ) );
 		}
+
+		void assign(spirea::d2d1::render_target const& rt, StyleType const& style)
+		{
+			style_ = style;
+			( ..., style_detail::style_adapter< Locs >::update( rt, style_ ) );
+		}
 	};
 
+	template <typename StyleType>
+	inline StyleType lerp_style(StyleType const& a, StyleType const& b, float t) noexcept
+	{
+		using namespace style_detail;
+
+		auto s = t < 0.5f ? a : b;
+		if constexpr( has_fg_color< StyleType >::value != location::none ) {
+			s.fg_color = lerp_optional( a.fg_color, b.fg_color, t );
+		}
+		if constexpr( has_bg_color< StyleType >::value != location::none ) {
+			s.bg_color = lerp_optional( a.bg_color, b.bg_color, t );
+		}
+		if constexpr( has_edge< StyleType >::value != location::none ) {
+			s.edge = lerp_optional( a.edge, b.edge, t );
+		}
+		if constexpr( has_text_color< StyleType >::value != location::none ) {
+			s.text_color = lerp_optional( a.text_color, b.text_color, t );
+		}
+		return s;
+	}
+
 } // namespace musket
 
 #endif // MUSKET_WIDGET_STYLE_HPP_
\ No newline at end of file
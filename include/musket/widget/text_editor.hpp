@@ -0,0 +1,623 @@
+//--------------------------------------------------------
+// musket/include/musket/widget/text_editor.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_WIDGET_TEXT_EDITOR_HPP_
+#define MUSKET_WIDGET_TEXT_EDITOR_HPP_
+
+#include <cmath>
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <algorithm>
+#include "facade.hpp"
+#include "../widget.hpp"
+#include "../detail/piece_table.hpp"
+#include "scroll_bar.hpp"
+
+namespace musket {
+
+	struct text_editor_style
+	{
+		std::optional< rgba8 > fg_color;
+		std::optional< rgba8 > bg_color;
+		std::optional< edge_property > edge;
+		std::optional< rgba8 > text_color;
+	};
+
+	class text_editor;
+
+	template <>
+	class default_style_t< text_editor >
+	{
+		inline static text_editor_style style_ = {
+			rgba_color_t{ 0.9f, 0.9f, 0.9f, 1.0f },
+			rgba_color_t{ 0.1f, 0.1f, 0.1f, 1.0f },
+			musket::edge_property{ { 0.5f, 0.5f, 0.5f, 1.0f }, 1.0f },
+			rgba_color_t{ 0.9f, 0.9f, 0.9f, 1.0f },
+		};
+
+		inline static std::mutex mtx_;
+
+	public:
+		static void set(text_editor_style const& style) noexcept
+		{
+			std::lock_guard lock{ mtx_ };
+			style_ = style;
+		}
+
+		static text_editor_style get() noexcept
+		{
+			std::lock_guard lock{ mtx_ };
+			return style_;
+		}
+	};
+
+	struct text_editor_property
+	{
+		std::optional< text_format > text_fmt = {};
+		std::optional< text_editor_style > style = {};
+		scroll_bar_property scroll_bar = {};
+		float line_height = 18.0f;
+		float scroll_bar_width = 16.0f;
+		float caret_width = 1.0f;
+		std::chrono::milliseconds caret_blink = std::chrono::milliseconds{ 530 };
+	};
+
+namespace detail {
+
+	inline std::size_t utf16_length(std::string_view s) noexcept
+	{
+		std::size_t n = 0;
+		for( std::size_t i = 0; i < s.size(); ) {
+			auto const c = static_cast< unsigned char >( s[i] );
+			if( c < 0x80 ) {
+				i += 1;
+				n += 1;
+			}
+			else if( c < 0xe0 ) {
+				i += 2;
+				n += 1;
+			}
+			else if( c < 0xf0 ) {
+				i += 3;
+				n += 1;
+			}
+			else {
+				i += 4;
+				n += 2;
+			}
+		}
+		return n;
+	}
+
+	inline std::size_t utf8_offset(std::string_view s, std::size_t utf16_index) noexcept
+	{
+		std::size_t i = 0;
+		std::size_t n = 0;
+		while( i < s.size() && n < utf16_index ) {
+			auto const c = static_cast< unsigned char >( s[i] );
+			auto const len = c < 0x80 ? 1u : c < 0xe0 ? 2u : c < 0xf0 ? 3u : 4u;
+			i += len;
+			n += len == 4 ? 2 : 1;
+		}
+		return std::min( i, s.size() );
+	}
+
+	inline std::string to_utf8(char32_t c)
+	{
+		std::string s;
+		if( c < 0x80 ) {
+			s += static_cast< char >( c );
+		}
+		else if( c < 0x800 ) {
+			s += static_cast< char >( 0xc0 | ( c >> 6 ) );
+			s += static_cast< char >( 0x80 | ( c & 0x3f ) );
+		}
+		else if( c < 0x10000 ) {
+			s += static_cast< char >( 0xe0 | ( c >> 12 ) );
+			s += static_cast< char >( 0x80 | ( ( c >> 6 ) & 0x3f ) );
+			s += static_cast< char >( 0x80 | ( c & 0x3f ) );
+		}
+		else {
+			s += static_cast< char >( 0xf0 | ( c >> 18 ) );
+			s += static_cast< char >( 0x80 | ( ( c >> 12 ) & 0x3f ) );
+			s += static_cast< char >( 0x80 | ( ( c >> 6 ) & 0x3f ) );
+			s += static_cast< char >( 0x80 | ( c & 0x3f ) );
+		}
+		return s;
+	}
+
+} // namespace detail
+
+	class text_editor :
+		public widget_facade
+	{
+		static constexpr std::size_t npos = std::numeric_limits< std::size_t >::max();
+
+		struct line
+		{
+			std::size_t index = npos;
+			spirea::dwrite::text_layout layout;
+		};
+
+		detail::piece_table text_;
+		float line_height_;
+		float scroll_bar_width_;
+		float caret_width_;
+		spirea::dwrite::text_format format_;
+		style_data_t< text_editor_style > data_;
+		std::vector< line > lines_;
+		std::size_t first_ = 0;
+		std::size_t caret_ = 0;
+		bool focused_ = false;
+		bool caret_on_ = true;
+		std::chrono::milliseconds caret_blink_;
+		timer_handle blink_;
+		std::shared_ptr< text_editor* > self_ = std::make_shared< text_editor* >( this );
+		widget< scroll_bar< axis_flag::vertical > > scroll_;
+		spirea::connection scroll_conn_;
+		spirea::connection focus_conn_;
+
+	public:
+		template <typename Rect>
+		text_editor(
+			Rect const& rc,
+			std::string_view str = {},
+			text_editor_property const& prop = {}
+		) :
+			widget_facade{ rc },
+			text_{ str },
+			line_height_{ prop.line_height },
+			scroll_bar_width_{ prop.scroll_bar_width },
+			caret_width_{ prop.caret_width },
+			caret_blink_{ prop.caret_blink },
+			data_{ deref_style< text_editor >( prop.style ) }
+		{
+			format_ = create_text_format( deref_text_format( prop.text_fmt ) );
+			format_->SetTextAlignment( spirea::dwrite::text_alignment::leading );
+			format_->SetParagraphAlignment( spirea::dwrite::paragraph_alignment::center );
+			format_->SetWordWrapping( DWRITE_WORD_WRAPPING_NO_WRAP );
+
+			scroll_ = { scroll_bar_rect(), static_cast< std::uint32_t >( visible_lines() ), static_cast< std::uint32_t >( text_.size_of_lines() ), prop.scroll_bar };
+			scroll_conn_ = scroll_->connect( scroll_bar_event::scroll{}, [this](std::uint32_t lower, std::uint32_t) {
+				first_ = lower;
+			} );
+
+			lines_.resize( visible_lines() + 1 );
+		}
+
+		~text_editor() noexcept
+		{
+			scroll_conn_.disconnect();
+			focus_conn_.disconnect();
+			scroll_.detach();
+		}
+
+		std::string text() const
+		{
+			return text_.str();
+		}
+
+		void set_text(std::string_view str)
+		{
+			text_ = detail::piece_table{ str };
+			caret_ = 0;
+			first_ = 0;
+			invalidate( 0 );
+			update_scroll_bar();
+		}
+
+		std::size_t size_of_text() const noexcept
+		{
+			return text_.size();
+		}
+
+		std::size_t size_of_lines() const noexcept
+		{
+			return text_.size_of_lines();
+		}
+
+		std::size_t caret() const noexcept
+		{
+			return caret_;
+		}
+
+		void set_caret(std::size_t pos) noexcept
+		{
+			caret_ = std::min( pos, text_.size() );
+			scroll_to_caret();
+		}
+
+		bool is_focused() const noexcept
+		{
+			return focused_;
+		}
+
+		void insert(std::size_t pos, std::string_view str)
+		{
+			pos = std::min( pos, text_.size() );
+			auto const l = text_.line_of( pos );
+			auto const prev_lines = text_.size_of_lines();
+
+			text_.insert( pos, str );
+			if( caret_ >= pos ) {
+				caret_ += str.size();
+			}
+
+			edited( l, prev_lines );
+		}
+
+		void erase(std::size_t pos, std::size_t n)
+		{
+			pos = std::min( pos, text_.size() );
+			n = std::min( n, text_.size() - pos );
+			auto const l = text_.line_of( pos );
+			auto const prev_lines = text_.size_of_lines();
+
+			text_.erase( pos, n );
+			if( caret_ > pos ) {
+				caret_ = caret_ >= pos + n ? caret_ - n : pos;
+			}
+
+			edited( l, prev_lines );
+		}
+
+		template <typename Rect>
+		void resize(Rect const& rc) noexcept
+		{
+			widget_facade::resize( rc );
+			scroll_->resize( scroll_bar_rect() );
+			update_scroll_bar();
+
+			lines_.clear();
+			lines_.resize( visible_lines() + 1 );
+		}
+
+		void show() noexcept
+		{
+			widget_facade::show();
+			scroll_->show();
+		}
+
+		void hide() noexcept
+		{
+			widget_facade::hide();
+			scroll_->hide();
+		}
+
+		void on_event(event::draw, window& wnd)
+		{
+			if( !is_visible() ) {
+				return;
+			}
+
+			auto const rt = wnd.render_target();
+			auto const rc = content_rect();
+			auto const rcf = spirea::rect_traits< spirea::d2d1::rect_f >::construct( rc );
+
+			data_.draw_background( rt, rcf );
+
+			rt->PushAxisAlignedClip( rcf, D2D1_ANTIALIAS_MODE_ALIASED );
+			auto const count = text_.size_of_lines();
+			for( std::size_t i = 0; i < lines_.size() && first_ + i < count; ++i ) {
+				auto const& l = acquire( first_ + i, rc.width() );
+				data_.draw_text( rt, { rc.left, rc.top + line_height_ * i }, l.layout );
+			}
+
+			if( focused_ && caret_on_ ) {
+				if( auto const crc = caret_rect() ) {
+					data_.draw_foreground( rt, spirea::rect_traits< spirea::d2d1::rect_f >::construct( *crc ) );
+				}
+			}
+			rt->PopAxisAlignedClip();
+
+			data_.draw_edge( rt, rcf );
+		}
+
+		void on_event(event::recreated_target, window& wnd)
+		{
+			data_.recreated_target( wnd.render_target() );
+		}
+
+		void on_event(event::attached, window& wnd)
+		{
+			scroll_.detach();
+			wnd.attach_widget( scroll_ );
+
+			focus_conn_.disconnect();
+			focus_conn_ = wnd.connect(
+				event::mouse_button_pressed{},
+				[this](window& wnd, mouse_button btn, mouse_button, cursor_position const& pt) {
+					auto const prev = focused_;
+					focused_ = is_visible() && contains( size(), pt );
+
+					if( focused_ && spirea::enabled( btn, mouse_button::left ) && contains( content_rect(), pt ) ) {
+						caret_ = hit_test( pt );
+						restart_blink( wnd );
+						wnd.redraw( size() );
+					}
+					else if( prev != focused_ ) {
+						if( focused_ ) {
+							restart_blink( wnd );
+						}
+						else {
+							wnd.cancel_timer( blink_ );
+						}
+						wnd.redraw( size() );
+					}
+				}
+			);
+		}
+
+		void on_event(widget_event::detached)
+		{
+			scroll_.detach();
+			focus_conn_.disconnect();
+			focused_ = false;
+		}
+
+		void on_event(event::key_pressed, window& wnd, virtual_key key)
+		{
+			if( !focused_ ) {
+				return;
+			}
+
+			auto const cl = text_.line_of( caret_ );
+			switch( key ) {
+			case VK_LEFT:
+				caret_ = prev_position( caret_ );
+				break;
+			case VK_RIGHT:
+				caret_ = next_position( caret_ );
+				break;
+			case VK_UP:
+				if( cl > 0 ) {
+					caret_ = move_to_line( cl, cl - 1 );
+				}
+				break;
+			case VK_DOWN:
+				if( cl + 1 < text_.size_of_lines() ) {
+					caret_ = move_to_line( cl, cl + 1 );
+				}
+				break;
+			case VK_HOME:
+				caret_ = text_.line_start( cl );
+				break;
+			case VK_END:
+				caret_ = text_.line_start( cl ) + text_.line( cl ).size();
+				break;
+			case VK_DELETE:
+				erase( caret_, next_position( caret_ ) - caret_ );
+				break;
+			default:
+				return;
+			}
+
+			scroll_to_caret();
+			restart_blink( wnd );
+			wnd.redraw( size() );
+		}
+
+		void on_event(event::char_input, window& wnd, char32_t c)
+		{
+			if( !focused_ ) {
+				return;
+			}
+
+			if( c == U'\b' ) {
+				auto const p = prev_position( caret_ );
+				erase( p, caret_ - p );
+			}
+			else if( c == U'\r' ) {
+				insert( caret_, "\n" );
+			}
+			else if( c == U'\t' || ( c >= 0x20 && c != 0x7f ) ) {
+				insert( caret_, detail::to_utf8( c ) );
+			}
+			else {
+				return;
+			}
+
+			scroll_to_caret();
+			restart_blink( wnd );
+			wnd.redraw( size() );
+		}
+
+	private:
+		void restart_blink(window& wnd)
+		{
+			wnd.cancel_timer( blink_ );
+			caret_on_ = true;
+			if( caret_blink_.count() <= 0 ) {
+				return;
+			}
+
+			blink_ = wnd.set_interval( caret_blink_, [self = std::weak_ptr< text_editor* >{ self_ }](window& wnd) {
+				if( auto const p = self.lock(); p && ( *p )->focused_ ) {
+					( *p )->caret_on_ = !( *p )->caret_on_;
+					if( auto const rc = ( *p )->caret_rect() ) {
+						wnd.redraw( *rc );
+					}
+				}
+			} );
+		}
+
+		template <typename Point>
+		static bool contains(spirea::rect_t< float > const& rc, Point const& pt) noexcept
+		{
+			return pt.x >= rc.left && pt.x <= rc.right && pt.y >= rc.top && pt.y <= rc.bottom;
+		}
+
+		spirea::rect_t< float > content_rect() const noexcept
+		{
+			auto rc = size();
+			rc.right = std::max( rc.right - scroll_bar_width_, rc.left );
+			return rc;
+		}
+
+		spirea::rect_t< float > scroll_bar_rect() const noexcept
+		{
+			auto const rc = size();
+			return { { rc.right - scroll_bar_width_, rc.top }, { scroll_bar_width_, rc.height() } };
+		}
+
+		std::optional< spirea::rect_t< float > > caret_rect()
+		{
+			auto const rc = content_rect();
+			auto const cl = text_.line_of( caret_ );
+			if( cl < first_ || cl >= first_ + lines_.size() ) {
+				return std::nullopt;
+			}
+
+			auto const& l = acquire( cl, rc.width() );
+			auto const str = text_.line( cl );
+			auto const col = std::min( caret_ - text_.line_start( cl ), str.size() );
+
+			DWRITE_HIT_TEST_METRICS m;
+			float x, y;
+			l.layout->HitTestTextPosition( static_cast< UINT32 >( detail::utf16_length( std::string_view{ str }.substr( 0, col ) ) ), FALSE, &x, &y, &m );
+
+			auto const top = rc.top + line_height_ * ( cl - first_ );
+			return spirea::rect_t< float >{ { rc.left + x, top }, { caret_width_, line_height_ } };
+		}
+
+		std::size_t visible_lines() const noexcept
+		{
+			return static_cast< std::size_t >( std::ceil( size().height() / line_height_ ) );
+		}
+
+		std::size_t full_visible_lines() const noexcept
+		{
+			return std::max< std::size_t >( static_cast< std::size_t >( size().height() / line_height_ ), 1 );
+		}
+
+		line const& acquire(std::size_t index, float width)
+		{
+			auto& l = lines_[index % lines_.size()];
+			if( l.index != index ) {
+				l.layout = create_text_layout( format_, spirea::rect_t< float >{ { 0.0f, 0.0f }, { width, line_height_ } }, text_.line( index ) );
+				l.index = index;
+			}
+			return l;
+		}
+
+		void invalidate(std::size_t first_line) noexcept
+		{
+			for( auto& l : lines_ ) {
+				if( l.index != npos && l.index >= first_line ) {
+					l.index = npos;
+				}
+			}
+		}
+
+		void edited(std::size_t l, std::size_t prev_lines) noexcept
+		{
+			if( text_.size_of_lines() != prev_lines ) {
+				invalidate( l );
+				update_scroll_bar();
+			}
+			else {
+				auto& slot = lines_[l % lines_.size()];
+				if( slot.index == l ) {
+					slot.index = npos;
+				}
+			}
+		}
+
+		void update_scroll_bar() noexcept
+		{
+			auto const count = text_.size_of_lines();
+			if( first_ >= count ) {
+				first_ = count - 1;
+			}
+			scroll_->set_values( static_cast< std::uint32_t >( visible_lines() ), static_cast< std::uint32_t >( count ) );
+			scroll_->set_position( static_cast< std::uint32_t >( first_ ) );
+		}
+
+		void scroll_to_caret() noexcept
+		{
+			auto const cl = text_.line_of( caret_ );
+			auto const full = full_visible_lines();
+			if( cl < first_ ) {
+				first_ = cl;
+			}
+			else if( cl >= first_ + full ) {
+				first_ = cl - full + 1;
+			}
+			else {
+				return;
+			}
+			scroll_->set_position( static_cast< std::uint32_t >( first_ ) );
+		}
+
+		std::size_t prev_position(std::size_t pos) const noexcept
+		{
+			if( pos == 0 ) {
+				return 0;
+			}
+
+			--pos;
+			while( pos > 0 && ( static_cast< unsigned char >( text_.at( pos ) ) & 0xc0 ) == 0x80 ) {
+				--pos;
+			}
+			if( pos > 0 && text_.at( pos ) == '\n' && text_.at( pos - 1 ) == '\r' ) {
+				--pos;
+			}
+			return pos;
+		}
+
+		std::size_t next_position(std::size_t pos) const noexcept
+		{
+			auto const sz = text_.size();
+			if( pos >= sz ) {
+				return sz;
+			}
+
+			if( text_.at( pos ) == '\r' && pos + 1 < sz && text_.at( pos + 1 ) == '\n' ) {
+				return pos + 2;
+			}
+
+			++pos;
+			while( pos < sz && ( static_cast< unsigned char >( text_.at( pos ) ) & 0xc0 ) == 0x80 ) {
+				++pos;
+			}
+			return pos;
+		}
+
+		std::size_t move_to_line(std::size_t from, std::size_t to) const
+		{
+			auto const from_str = text_.line( from );
+			auto const col = std::min( caret_ - text_.line_start( from ), from_str.size() );
+			auto const col16 = detail::utf16_length( std::string_view{ from_str }.substr( 0, col ) );
+
+			auto const to_str = text_.line( to );
+			return text_.line_start( to ) + detail::utf8_offset( to_str, col16 );
+		}
+
+		std::size_t hit_test(cursor_position const& pt)
+		{
+			auto const rc = content_rect();
+			auto const count = text_.size_of_lines();
+			auto const l = std::min( first_ + static_cast< std::size_t >( std::max( pt.y - rc.top, 0.0f ) / line_height_ ), count - 1 );
+
+			auto const& slot = acquire( l, rc.width() );
+			BOOL trailing, inside;
+			DWRITE_HIT_TEST_METRICS m;
+			slot.layout->HitTestPoint( pt.x - rc.left, line_height_ * 0.5f, &trailing, &inside, &m );
+
+			auto const str = text_.line( l );
+			return text_.line_start( l ) + detail::utf8_offset( str, m.textPosition + ( trailing ? m.length : 0 ) );
+		}
+	};
+
+	using auto_scaling_text_editor = auto_resizer< text_editor >;
+
+} // namespace musket
+
+#endif // MUSKET_WIDGET_TEXT_EDITOR_HPP_
\ No newline at end of file
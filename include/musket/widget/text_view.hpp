@@ -0,0 +1,272 @@
+//--------------------------------------------------------
+// musket/include/musket/widget/text_view.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_WIDGET_TEXT_VIEW_HPP_
+#define MUSKET_WIDGET_TEXT_VIEW_HPP_
+
+#include <cmath>
+#include <memory>
+#include <algorithm>
+#include "facade.hpp"
+#include "../widget.hpp"
+#include "../detail/lru_cache.hpp"
+#include "../detail/mapped_file.hpp"
+#include "../detail/line_index.hpp"
+#include "scroll_bar.hpp"
+
+namespace musket {
+
+	struct text_view_style
+	{
+		std::optional< rgba8 > bg_color;
+		std::optional< edge_property > edge;
+		std::optional< rgba8 > text_color;
+	};
+
+	class text_view;
+
+	template <>
+	class default_style_t< text_view >
+	{
+		inline static text_view_style style_ = {
+			rgba_color_t{ 0.1f, 0.1f, 0.1f, 1.0f },
+			musket::edge_property{ { 0.5f, 0.5f, 0.5f, 1.0f }, 1.0f },
+			rgba_color_t{ 0.9f, 0.9f, 0.9f, 1.0f },
+		};
+
+		inline static std::mutex mtx_;
+
+	public:
+		static void set(text_view_style const& style) noexcept
+		{
+			std::lock_guard lock{ mtx_ };
+			style_ = style;
+		}
+
+		static text_view_style get() noexcept
+		{
+			std::lock_guard lock{ mtx_ };
+			return style_;
+		}
+	};
+
+	struct text_view_property
+	{
+		std::optional< text_format > text_fmt = {};
+		std::optional< text_view_style > style = {};
+		scroll_bar_property scroll_bar = {};
+		float line_height = 18.0f;
+		float scroll_bar_width = 16.0f;
+		std::size_t cache_capacity = 256;
+		std::size_t max_line_length = 4096;
+	};
+
+	class text_view :
+		public widget_facade
+	{
+		std::shared_ptr< detail::file_mapping const > file_;
+		detail::mapped_view view_;
+		std::unique_ptr< detail::line_index > index_;
+		std::shared_ptr< detail::frame_requester > frames_ = std::make_shared< detail::frame_requester >();
+		float line_height_;
+		float scroll_bar_width_;
+		std::size_t max_line_length_;
+		spirea::dwrite::text_format format_;
+		style_data_t< text_view_style > data_;
+		detail::lru_cache< std::uint64_t, spirea::dwrite::text_layout > cache_;
+		std::uint64_t first_ = 0;
+		std::uint64_t known_lines_ = 0;
+		widget< scroll_bar< axis_flag::vertical > > scroll_;
+		spirea::connection scroll_conn_;
+
+	public:
+		template <typename Rect>
+		text_view(
+			Rect const& rc,
+			std::string_view path,
+			text_view_property const& prop = {}
+		) :
+			widget_facade{ rc },
+			line_height_{ prop.line_height },
+			scroll_bar_width_{ prop.scroll_bar_width },
+			max_line_length_{ prop.max_line_length },
+			data_{ deref_style< text_view >( prop.style ) },
+			cache_{ prop.cache_capacity }
+		{
+			format_ = create_text_format( deref_text_format( prop.text_fmt ) );
+			format_->SetTextAlignment( spirea::dwrite::text_alignment::leading );
+			format_->SetParagraphAlignment( spirea::dwrite::paragraph_alignment::center );
+			format_->SetWordWrapping( DWRITE_WORD_WRAPPING_NO_WRAP );
+
+			scroll_ = { scroll_bar_rect(), static_cast< std::uint32_t >( visible_lines() ), 0u, prop.scroll_bar };
+			scroll_conn_ = scroll_->connect( scroll_bar_event::scroll{}, [this](std::uint32_t lower, std::uint32_t) {
+				first_ = lower;
+			} );
+
+			open( path );
+		}
+
+		~text_view() noexcept
+		{
+			scroll_conn_.disconnect();
+			scroll_.detach();
+		}
+
+		void open(std::string_view path)
+		{
+			index_.reset();
+			view_.reset();
+			cache_.clear();
+			first_ = 0;
+			known_lines_ = 0;
+
+			file_ = std::make_shared< detail::file_mapping >( path );
+			view_ = file_->view();
+			index_ = std::make_unique< detail::line_index >( file_, [frames = frames_] { frames->request(); } );
+
+			scroll_->set_values( static_cast< std::uint32_t >( visible_lines() ), 0 );
+		}
+
+		std::uint64_t size_of_lines() const noexcept
+		{
+			return index_ ? index_->size() : 0;
+		}
+
+		bool is_indexed() const noexcept
+		{
+			return index_ && index_->is_complete();
+		}
+
+		std::exception_ptr index_error() const
+		{
+			return index_ ? index_->error() : nullptr;
+		}
+
+		std::size_t index_memory_usage() const noexcept
+		{
+			return index_ ? index_->memory_usage() : 0;
+		}
+
+		template <typename Rect>
+		void resize(Rect const& rc) noexcept
+		{
+			widget_facade::resize( rc );
+			scroll_->resize( scroll_bar_rect() );
+			scroll_->set_values( static_cast< std::uint32_t >( visible_lines() ), static_cast< std::uint32_t >( known_lines_ ) );
+			cache_.clear();
+		}
+
+		void show() noexcept
+		{
+			widget_facade::show();
+			scroll_->show();
+		}
+
+		void hide() noexcept
+		{
+			widget_facade::hide();
+			scroll_->hide();
+		}
+
+		void on_event(event::idle, window& wnd)
+		{
+			frames_->reset();
+			if( update_lines() && is_visible() ) {
+				wnd.redraw( size() );
+			}
+		}
+
+		void on_event(event::draw, window& wnd)
+		{
+			update_lines();
+
+			if( !is_visible() ) {
+				return;
+			}
+
+			auto const rt = wnd.render_target();
+			auto const rc = content_rect();
+			auto const rcf = spirea::rect_traits< spirea::d2d1::rect_f >::construct( rc );
+
+			data_.draw_background( rt, rcf );
+
+			rt->PushAxisAlignedClip( rcf, D2D1_ANTIALIAS_MODE_ALIASED );
+			auto const visible = visible_lines();
+			for( std::size_t i = 0; i < visible; ++i ) {
+				auto const n = first_ + i;
+				if( n >= known_lines_ ) {
+					break;
+				}
+
+				auto const& layout = cache_.get_or_insert( n, [&] {
+					auto const str = index_->line( n, view_.data(), max_line_length_ ).value_or( std::string_view{} );
+					return create_text_layout( format_, spirea::rect_t< float >{ { 0.0f, 0.0f }, { rc.width(), line_height_ } }, str );
+				} );
+				data_.draw_text( rt, { rc.left, rc.top + line_height_ * i }, layout );
+			}
+			rt->PopAxisAlignedClip();
+
+			data_.draw_edge( rt, rcf );
+		}
+
+		void on_event(event::recreated_target, window& wnd)
+		{
+			data_.recreated_target( wnd.render_target() );
+		}
+
+		void on_event(event::attached, window& wnd)
+		{
+			frames_->bind( wnd.window_handle().handle() );
+			scroll_.detach();
+			wnd.attach_widget( scroll_ );
+		}
+
+		void on_event(widget_event::detached)
+		{
+			scroll_.detach();
+		}
+
+	private:
+		bool update_lines()
+		{
+			auto const n = size_of_lines();
+			if( n == known_lines_ ) {
+				return false;
+			}
+
+			auto const visible_before = first_ + visible_lines() > known_lines_;
+			known_lines_ = n;
+			scroll_->set_values( static_cast< std::uint32_t >( visible_lines() ), static_cast< std::uint32_t >( std::min< std::uint64_t >( n, UINT32_MAX ) ) );
+			return visible_before || index_->is_complete();
+		}
+
+		spirea::rect_t< float > content_rect() const noexcept
+		{
+			auto rc = size();
+			rc.right = std::max( rc.right - scroll_bar_width_, rc.left );
+			return rc;
+		}
+
+		spirea::rect_t< float > scroll_bar_rect() const noexcept
+		{
+			auto const rc = size();
+			return { { rc.right - scroll_bar_width_, rc.top }, { scroll_bar_width_, rc.height() } };
+		}
+
+		std::size_t visible_lines() const noexcept
+		{
+			return static_cast< std::size_t >( std::ceil( size().height() / line_height_ ) );
+		}
+	};
+
+	using auto_scaling_text_view = auto_resizer< text_view >;
+
+} // namespace musket
+
+#endif // MUSKET_WIDGET_TEXT_VIEW_HPP_
\ No newline at end of file
@@ -0,0 +1,104 @@
+//--------------------------------------------------------
+// musket/include/musket/widget/transition.hpp
+//
+// Copyright (C) 2018 LNSEAB
+//
+// released under the MIT License.
+// https://opensource.org/licenses/MIT
+//--------------------------------------------------------
+
+#ifndef MUSKET_WIDGET_TRANSITION_HPP_
+#define MUSKET_WIDGET_TRANSITION_HPP_
+
+#include <chrono>
+#include <memory>
+#include "style.hpp"
+#include "../window.hpp"
+#include "../detail/animator.hpp"
+
+namespace musket {
+
+	constexpr std::chrono::milliseconds default_transition_duration{ 120 };
+
+	inline spirea::rect_t< float > lerp_rect(spirea::rect_t< float > const& a, spirea::rect_t< float > const& b, float t) noexcept
+	{
+		auto rc = a;
+		rc.left = a.left + ( b.left - a.left ) * t;
+		rc.top = a.top + ( b.top - a.top ) * t;
+		rc.right = a.right + ( b.right - a.right ) * t;
+		rc.bottom = a.bottom + ( b.bottom - a.bottom ) * t;
+		return rc;
+	}
+
+	template <typename StyleType>
+	class style_transition
+	{
+		using style_data_type = style_data_t< StyleType >;
+
+		struct blend
+		{
+			style_data_type data;
+			StyleType from;
+			StyleType to;
+			animation anim;
+			float value = -1.0f;
+		};
+
+		std::unique_ptr< blend > blend_;
+		std::chrono::milliseconds duration_;
+		easing easing_;
+
+	public:
+		style_transition(std::chrono::milliseconds duration = default_transition_duration, easing e = easing::ease_out) :
+			duration_{ duration },
+			easing_{ e }
+		{ }
+
+		bool is_running() const noexcept
+		{
+			return blend_ && blend_->anim.is_running();
+		}
+
+		template <typename Rect>
+		void start(window& wnd, StyleType const& from, StyleType const& to, Rect const& bounds)
+		{
+			if( duration_.count() <= 0 ) {
+				return;
+			}
+
+			if( !blend_ ) {
+				blend_ = std::make_unique< blend >();
+			}
+
+			blend_->from = blend_->anim.is_running() ? lerp_style( blend_->from, blend_->to, blend_->anim.value() ) : from;
+			blend_->to = to;
+			blend_->value = -1.0f;
+			blend_->anim = wnd.animate( 0.0f, 1.0f, duration_, bounds, easing_ );
+		}
+
+		style_data_type const& get(spirea::d2d1::render_target const& rt, style_data_type const& target)
+		{
+			if( !is_running() ) {
+				blend_.reset();
+				return target;
+			}
+
+			auto const t = blend_->anim.value();
+			if( t != blend_->value ) {
+				blend_->data.assign( rt, lerp_style( blend_->from, blend_->to, t ) );
+				blend_->value = t;
+			}
+			return blend_->data;
+		}
+
+		void recreated_target(spirea::d2d1::render_target const& rt)
+		{
+			if( blend_ ) {
+				blend_->data.recreated_target( rt );
+			}
+		}
+	};
+
+} // namespace musket
+
+#endif // MUSKET_WIDGET_TRANSITION_HPP_
\ No newline at end of file
@@ -10,6 +10,10 @@
 #ifndef MUSKET_WINDOW_HPP_
 #define MUSKET_WINDOW_HPP_
 
+#include <chrono>
+#include <atomic>
+#include <optional>
+#include <functional>
 #include <spirea/windows/api.hpp>
 #include <spirea/windows/window.hpp>
 #include <spirea/windows/d2d1.hpp>
@@ -17,6 +21,13 @@
 #include "color.hpp"
 #include "context.hpp"
 #include "event.hpp"
+#include "stats.hpp"
+#include "input_recording.hpp"
+#include "arena.hpp"
+#include "detail/timer_wheel.hpp"
+#include "detail/animator.hpp"
+#include "detail/draw_profiler.hpp"
+#include "detail/offscreen_target.hpp"
 
 namespace musket {
 
@@ -40,22 +51,67 @@ namespace window_type {
 		static constexpr DWORD ex_style = 0;
 	};
 
+	struct offscreen
+	{
+		float dpi = 96.0f;
+	};
+
 } // namespace window_type
 
 namespace detail {
 
 	struct window_context;
 
+	inline void invalidate_widget(std::weak_ptr< window_context > const& wc, spirea::rect_t< float > const& rc) noexcept;
+	inline void invalidate_background_layer(std::shared_ptr< window_context > const& wc) noexcept;
+	inline void forget_widget(std::shared_ptr< window_context > const& wc, void const* instance) noexcept;
+
+	constexpr UINT wm_run_tasks = WM_APP + 1;
+	constexpr UINT wm_request_frame = WM_APP + 2;
+	constexpr UINT_PTR frame_timer_id = 1;
+
+	class frame_requester
+	{
+		std::atomic< HWND > hwnd_{ nullptr };
+		std::atomic< bool > requested_{ false };
+
+	public:
+		void bind(HWND hwnd) noexcept
+		{
+			hwnd_.store( hwnd, std::memory_order_release );
+			if( requested_.load( std::memory_order_acquire ) ) {
+				PostMessageW( hwnd, wm_request_frame, 0, 0 );
+			}
+		}
+
+		void request() noexcept
+		{
+			if( requested_.exchange( true, std::memory_order_acq_rel ) ) {
+				return;
+			}
+			if( auto const hwnd = hwnd_.load( std::memory_order_acquire ) ) {
+				PostMessageW( hwnd, wm_request_frame, 0, 0 );
+			}
+		}
+
+		void reset() noexcept
+		{
+			requested_.store( false, std::memory_order_release );
+		}
+	};
+
 } // namespace detail
 
 	using window_events = events_holder<
 		event::idle,
 		event::draw,
-		event::recreated_target,
+		event::detail::draw_static,
 		event::resized,
 		event::mouse_button_pressed,
 		event::mouse_button_released,
 		event::detail::mouse_moved_distributor,
+		event::key_pressed,
+		event::char_input,
 		event::detail::auto_resize,
 		event::detail::auto_relocation
 	>;
@@ -69,9 +125,18 @@ namespace detail {
 		event::mouse_button_released,
 		event::mouse_entered,
 		event::mouse_leaved,
-		event::mouse_moved
+		event::mouse_moved,
+		event::key_pressed,
+		event::char_input
 	>;
 
+	struct invalidation_counters
+	{
+		std::uint64_t requests = 0;
+		std::uint64_t full_redraws = 0;
+		float area = 0.0f;
+	};
+
 	template <typename>
 	class widget;
 	
@@ -97,18 +162,110 @@ namespace detail {
 		void show() noexcept;
 		void hide() noexcept;
 		void redraw() const noexcept;
+
+		template <typename Rect>
+		void redraw(Rect const& rc) const noexcept;
+
+		void redraw_background() const noexcept;
+		void request_idle_frame() const noexcept;
 		void close() noexcept;
 
 		spirea::rect_t< float > client_area_size() const noexcept;
 
 		spirea::windows::window window_handle() const noexcept;
-		spirea::d2d1::hwnd_render_target render_target() const noexcept;
+		spirea::d2d1::render_target render_target() const noexcept;
+		std::uint64_t target_generation() const noexcept;
+
+		frame_stats stats() const;
+
+		void set_draw_profiling(bool enabled) noexcept;
+		void show_draw_cost_overlay(bool visible) noexcept;
+		void reset_draw_profile() noexcept;
+		std::vector< widget_cost > top_widgets(std::size_t n) const;
+		std::vector< widget_type_cost > widget_type_costs() const;
+
+		void dispatch_input(input_record const& r);
+		void start_input_recording();
+		input_recording stop_input_recording();
+		bool is_recording_input() const noexcept;
+		void replay_input(input_recording recording, replay_speed speed = replay_speed::real_time);
+		void stop_input_replay() noexcept;
+		bool is_replaying_input() const noexcept;
+
+		void render_to(spirea::d2d1::render_target const& rt);
+		bitmap render_to_bitmap();
+		void render_to_bitmap(bitmap_view const& dst);
+		bool is_offscreen() const noexcept;
+		invalidation_counters take_invalidations() noexcept;
 
 		template <typename T>
 		void attach_widget(widget< T >& w);
 
+		void set_arena(std::shared_ptr< widget_arena > arena) noexcept;
+		std::shared_ptr< widget_arena > const& arena() const noexcept;
+
 		template <typename Event, typename F>
 		spirea::connection connect(Event, F&& f);
+
+		template <typename F>
+		bool post(F&& f) const;
+
+		void set_task_budget(std::chrono::microseconds budget) noexcept;
+
+		template <typename F>
+		timer_handle set_timer(std::chrono::milliseconds delay, F&& f);
+
+		template <typename F>
+		timer_handle set_interval(std::chrono::milliseconds period, F&& f);
+
+		bool cancel_timer(timer_handle h) noexcept;
+
+		template <typename Rect>
+		animation animate(float from, float to, std::chrono::milliseconds duration, Rect const& bounds, easing e = easing::ease_out);
+
+		friend class render_target_scope;
+		friend class invalidation_scope;
+
+		template <typename Widget, typename Object, typename F>
+		friend void detail::profile_widget(Widget& w, Object& obj, bool draw, F&& f);
+
+		friend struct detail::window_context;
+
+	private:
+		explicit window(std::shared_ptr< detail::window_context > p) noexcept :
+			p_{ std::move( p ) }
+		{ }
+	};
+
+	class render_target_scope
+	{
+		std::shared_ptr< detail::window_context > p_;
+		spirea::d2d1::render_target prev_;
+
+	public:
+		render_target_scope(window& wnd, spirea::d2d1::render_target const& rt) noexcept;
+		~render_target_scope() noexcept;
+
+		render_target_scope(render_target_scope const&) = delete;
+		render_target_scope& operator=(render_target_scope const&) = delete;
+	};
+
+	class invalidation_scope
+	{
+		std::shared_ptr< detail::window_context > p_;
+		invalidation_scope* prev_;
+		std::function< void (std::optional< spirea::rect_t< float > > const&) > f_;
+		spirea::point_t< float > origin_;
+
+	public:
+		template <typename F>
+		invalidation_scope(window& wnd, F&& f, spirea::point_t< float > const& origin = { 0.0f, 0.0f });
+		~invalidation_scope() noexcept;
+
+		invalidation_scope(invalidation_scope const&) = delete;
+		invalidation_scope& operator=(invalidation_scope const&) = delete;
+
+		friend struct detail::window_context;
 	};
 
 	inline int loop()
@@ -121,6 +278,8 @@ namespace detail {
 		return spirea::windows::window::idle_loop();
 	}
 
+	inline int event_loop();
+
 } // namespace musket
 
 #endif // MUSKET_WINDOW_HPP_
\ No newline at end of file